@@ -0,0 +1,93 @@
+/*
+ * Arena.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "Arena.hpp"
+
+#include <algorithm>
+
+using namespace MJSON;
+
+constexpr std::size_t Arena::c_FIRST_CHUNK_SIZE;
+constexpr std::size_t Arena::c_MAX_CHUNK_SIZE;
+
+Arena::~Arena()
+{
+	for(auto& chunk : m_chunks)
+	{
+		::operator delete(chunk.m_data);
+	}
+}
+
+void* Arena::_allocate_slow(std::size_t size, std::size_t alignment)
+{
+	//Move on to a chunk kept from before a reset if it is big enough, otherwise insert a new one.
+	//Chunks double in size so the number of chunks stays logarithmic in the document size.
+	std::size_t required = size + alignment;
+	std::size_t next_chunk = m_cursor == nullptr ? 0 : m_current_chunk + 1;
+
+	if(next_chunk >= m_chunks.size() || m_chunks[next_chunk].m_size < required)
+	{
+		std::size_t chunk_size = m_chunks.empty() ? c_FIRST_CHUNK_SIZE : std::min(m_chunks.back().m_size * 2, c_MAX_CHUNK_SIZE);
+		chunk_size = std::max(chunk_size, required);
+		Chunk chunk { static_cast<char*>(::operator new(chunk_size)), chunk_size };
+		next_chunk = std::min(next_chunk, m_chunks.size());
+		m_chunks.insert(m_chunks.begin() + next_chunk, chunk);
+	}
+
+	m_current_chunk = next_chunk;
+	m_cursor = m_chunks[next_chunk].m_data;
+	m_end = m_cursor + m_chunks[next_chunk].m_size;
+	return allocate(size, alignment);
+}
+
+void Arena::reset()
+{
+	m_current_chunk = 0;
+	m_cursor = nullptr;
+	m_end = nullptr;
+	m_adopted.clear();
+}
+
+void Arena::adopt(std::unique_ptr<Arena> other)
+{
+	if(other != nullptr)
+		m_adopted.push_back(std::move(other));
+}
+
+std::size_t Arena::get_bytes_reserved() const
+{
+	std::size_t bytes = 0;
+	for(auto& chunk : m_chunks)
+	{
+		bytes += chunk.m_size;
+	}
+	for(auto& adopted : m_adopted)
+	{
+		bytes += adopted->get_bytes_reserved();
+	}
+	return bytes;
+}
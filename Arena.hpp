@@ -0,0 +1,141 @@
+/*
+ * Arena.hpp
+ * Bump allocator owning the memory of one parsed document.  Variants, their container storage and
+ * their strings are all carved out of large chunks, which are freed together when the arena is
+ * destroyed.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace MJSON
+{
+	class Arena
+	{
+	public:
+		static constexpr std::size_t c_FIRST_CHUNK_SIZE = 16 * 1024;
+		static constexpr std::size_t c_MAX_CHUNK_SIZE = 4 * 1024 * 1024;
+
+		Arena() = default;
+		~Arena();
+
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		void* allocate(std::size_t size, std::size_t alignment);
+
+		//Objects created in the arena never have their destructors run, so only types whose memory
+		//also comes from the arena (or who own no memory at all) should be created here.
+		template<typename T, typename... Args>
+		T* create(Args&&... args)
+		{
+			return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		void reset(); //discards everything allocated, keeping the chunks for reuse
+
+		//Keeps another arena alive for as long as this one, so a tree built across several arenas (such as one
+		//per thread) can be owned through its root's arena.  Containers keep allocating from their own arena.
+		void adopt(std::unique_ptr<Arena> other);
+
+		std::size_t get_chunk_count() const {return m_chunks.size();}
+		std::size_t get_bytes_reserved() const;
+
+	private:
+		struct Chunk
+		{
+			char* m_data;
+			std::size_t m_size;
+		};
+
+		void* _allocate_slow(std::size_t size, std::size_t alignment);
+
+		char* m_cursor = nullptr;
+		char* m_end = nullptr;
+		std::vector<Chunk> m_chunks;
+		std::size_t m_current_chunk = 0;
+		std::vector<std::unique_ptr<Arena>> m_adopted;
+	};
+
+	inline void* Arena::allocate(std::size_t size, std::size_t alignment)
+	{
+		std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(m_cursor) + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+		if(m_cursor != nullptr && aligned + size <= reinterpret_cast<std::uintptr_t>(m_end))
+		{
+			m_cursor = reinterpret_cast<char*>(aligned + size);
+			return reinterpret_cast<void*>(aligned);
+		}
+		return _allocate_slow(size, alignment);
+	}
+
+	//STL allocator drawing from an Arena.  Without an arena it falls back to the global heap, so types using
+	//it can still be created outside of a parsed document.  Deallocation is a no-op for arena memory.
+	template<typename T>
+	class ArenaAllocator
+	{
+	public:
+		using value_type = T;
+
+		ArenaAllocator() = default;
+		ArenaAllocator(Arena* arena): m_arena(arena) {}
+
+		template<typename U>
+		ArenaAllocator(const ArenaAllocator<U>& other): m_arena(other.get_arena()) {}
+
+		T* allocate(std::size_t n)
+		{
+			if(m_arena)
+				return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		}
+
+		void deallocate(T* p, std::size_t)
+		{
+			if(!m_arena)
+				::operator delete(p);
+		}
+
+		//Copies of arena backed containers (e.g. a std::string copied out of a Variant) go to the heap,
+		//so they stay valid after the document is released.
+		ArenaAllocator select_on_container_copy_construction() const {return ArenaAllocator();}
+
+		Arena* get_arena() const {return m_arena;}
+
+	private:
+		Arena* m_arena = nullptr;
+	};
+
+	template<typename T, typename U>
+	bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {return a.get_arena() == b.get_arena();}
+
+	template<typename T, typename U>
+	bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {return a.get_arena() != b.get_arena();}
+}
@@ -0,0 +1,308 @@
+/*
+ * Binding.hpp
+ * Reads JSON straight into C++ types without building a Variant tree.  Structs are described with
+ * MJSON_BIND, or by specialising Binding<T>.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "MJSONEnums.hpp"
+#include "NumberParser.hpp"
+#include "StringRef.hpp"
+#include "Tokeniser.hpp"
+
+namespace MJSON
+{
+	class BindingReader;
+
+	//Binding<T>::read(BindingReader&, T&) reads one JSON value into a T.  Specialisations are provided for
+	//bool, arithmetic types, std::string, StringRef, std::vector, std::array and bound structs.
+	template<typename T, typename Enable = void>
+	struct Binding;
+
+	//A struct member and the key it is read from
+	template<typename Struct, typename Member>
+	struct BoundField
+	{
+		StringRef m_key;
+		Member Struct::* m_member;
+	};
+
+	template<typename Struct, typename Member>
+	BoundField<Struct, Member> make_field(StringRef key, Member Struct::* member)
+	{
+		return BoundField<Struct, Member>{key, member};
+	}
+
+	//Pulls values from the source on demand.  Nothing is allocated other than by the types being read into,
+	//unknown keys are skipped without being parsed and a null leaves the value being read unchanged.  Strings
+	//are read as they appear in the source, escape sequences are kept as in the Variant tree.
+	class BindingReader
+	{
+	public:
+		BindingReader(const char* json_src, std::size_t length):
+			m_cursor(json_src), m_end(json_src + length)
+		{}
+
+		explicit BindingReader(StringRef json_src):
+			BindingReader(json_src.data(), json_src.size())
+		{}
+
+		template<typename T>
+		void read(T& value)
+		{
+			_skip_whitespace();
+			assert(m_cursor < m_end && "Expected a value, reached the end of the source\n");
+			if(*m_cursor == 'n')
+				m_cursor = Tokeniser::find_literal_end(m_cursor, m_end);
+			else
+				Binding<T>::read(*this, value);
+		}
+
+		bool read_bool()
+		{
+			_skip_whitespace();
+			assert(m_cursor < m_end && (*m_cursor == 't' || *m_cursor == 'f') && "Expected a bool\n");
+			bool value = *m_cursor == 't';
+			m_cursor = Tokeniser::find_literal_end(m_cursor, m_end);
+			return value;
+		}
+
+		ParsedNumber read_number()
+		{
+			_skip_whitespace();
+			assert(m_cursor < m_end && Enums::char_to_e_char(*m_cursor) == Enums::e_char::NUMBER && "Expected a number\n");
+			const char* number_end = Tokeniser::find_number_end(m_cursor, m_end);
+			ParsedNumber number = NumberParser::parse(StringRef(m_cursor, number_end));
+			m_cursor = number_end;
+			return number;
+		}
+
+		StringRef read_string() //references the source
+		{
+			_skip_whitespace();
+			assert(m_cursor < m_end && *m_cursor == '"' && "Expected a string\n");
+			const char* str_end = Tokeniser::find_string_end(m_cursor + 1, m_end);
+			StringRef str(m_cursor + 1, str_end);
+			m_cursor = str_end + 1;
+			return str;
+		}
+
+		void skip_value()
+		{
+			_skip_whitespace();
+			m_cursor = Tokeniser::find_value_end(m_cursor, m_end);
+		}
+
+		//Objects are read with start_object() followed by next_key() until it returns false, reading or skipping
+		//the value after each key.  Arrays are read the same way with start_array() and next_element().
+		void start_object() {_expect('{');}
+		bool next_key(StringRef& key)
+		{
+			if(!_next('}'))
+				return false;
+			key = read_string();
+			_expect(':');
+			return true;
+		}
+
+		void start_array() {_expect('[');}
+		bool next_element() {return _next(']');}
+
+		template<typename Struct, typename... Fields>
+		void read_fields(Struct& value, const std::tuple<Fields...>& fields)
+		{
+			start_object();
+			StringRef key;
+			while(next_key(key))
+			{
+				if(!_read_field(value, fields, key, std::index_sequence_for<Fields...>()))
+					skip_value();
+			}
+		}
+
+		bool is_finished()
+		{
+			_skip_whitespace();
+			return m_cursor >= m_end;
+		}
+
+	private:
+		void _skip_whitespace() {m_cursor = Tokeniser::skip_whitespace(m_cursor, m_end);}
+
+		void _expect(char c)
+		{
+			_skip_whitespace();
+			assert(m_cursor < m_end && *m_cursor == c && "Unexpected character, the source does not match the bound type\n");
+			(void)c;
+			m_cursor++;
+		}
+
+		//Consumes the separator before the next member or element, false once the container has ended
+		bool _next(char container_end)
+		{
+			_skip_whitespace();
+			assert(m_cursor < m_end && "Unterminated container found\n");
+			if(*m_cursor == container_end)
+			{
+				m_cursor++;
+				return false;
+			}
+			if(*m_cursor == ',')
+			{
+				m_cursor++;
+				_skip_whitespace();
+			}
+			return true;
+		}
+
+		template<typename Struct, typename... Fields, std::size_t... Idx>
+		bool _read_field(Struct& value, const std::tuple<Fields...>& fields, StringRef key, std::index_sequence<Idx...>)
+		{
+			bool found = false;
+			int expand[] = {0, (found = found || _read_if_matches(value, std::get<Idx>(fields), key), 0)...};
+			(void)expand;
+			return found;
+		}
+
+		template<typename Struct, typename Member>
+		bool _read_if_matches(Struct& value, const BoundField<Struct, Member>& field, StringRef key)
+		{
+			if(field.m_key != key)
+				return false;
+			read(value.*field.m_member);
+			return true;
+		}
+
+		const char* m_cursor;
+		const char* m_end;
+	};
+
+	template<typename T>
+	void read_json(StringRef json_src, T& value)
+	{
+		BindingReader reader(json_src);
+		reader.read(value);
+		assert(reader.is_finished() && "Unexpected characters after the root value\n");
+	}
+
+	template<>
+	struct Binding<bool>
+	{
+		static void read(BindingReader& reader, bool& value) {value = reader.read_bool();}
+	};
+
+	template<typename T>
+	struct Binding<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type>
+	{
+		static void read(BindingReader& reader, T& value)
+		{
+			ParsedNumber number = reader.read_number();
+			value = number.m_type == Enums::e_number::UINT64 ? (T)number.m_uint64 : (T)number.to_int64();
+		}
+	};
+
+	template<typename T>
+	struct Binding<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+	{
+		static void read(BindingReader& reader, T& value) {value = (T)reader.read_number().to_double();}
+	};
+
+	template<>
+	struct Binding<StringRef> //only valid while the source is
+	{
+		static void read(BindingReader& reader, StringRef& value) {value = reader.read_string();}
+	};
+
+	template<>
+	struct Binding<std::string>
+	{
+		static void read(BindingReader& reader, std::string& value)
+		{
+			StringRef str = reader.read_string();
+			value.assign(str.data(), str.size());
+		}
+	};
+
+	template<typename T, typename Alloc>
+	struct Binding<std::vector<T, Alloc>>
+	{
+		static void read(BindingReader& reader, std::vector<T, Alloc>& value)
+		{
+			value.clear();
+			reader.start_array();
+			while(reader.next_element())
+			{
+				value.emplace_back();
+				reader.read(value.back());
+			}
+		}
+	};
+
+	template<typename T, std::size_t N>
+	struct Binding<std::array<T, N>> //extra elements are skipped, missing ones are left unchanged
+	{
+		static void read(BindingReader& reader, std::array<T, N>& value)
+		{
+			reader.start_array();
+			for(std::size_t idx = 0; reader.next_element(); idx++)
+			{
+				if(idx < N)
+					reader.read(value[idx]);
+				else
+					reader.skip_value();
+			}
+		}
+	};
+}
+
+//Binds a struct's members to keys of the same name, or to other keys with MJSON_FIELD_AS.  Must be used in the
+//global namespace:
+//	MJSON_BIND(Transform, MJSON_FIELD(m_position), MJSON_FIELD_AS("scale", m_scale))
+#define MJSON_FIELD(member) ::MJSON::make_field(#member, &Bound_t::member)
+#define MJSON_FIELD_AS(key, member) ::MJSON::make_field(key, &Bound_t::member)
+#define MJSON_BIND(Type, ...)																\
+	namespace MJSON																			\
+	{																						\
+		template<>																			\
+		struct Binding<Type>																\
+		{																					\
+			using Bound_t = Type;															\
+			static void read(BindingReader& reader, Type& value)							\
+			{																				\
+				static const auto c_FIELDS = std::make_tuple(__VA_ARGS__);					\
+				reader.read_fields(value, c_FIELDS);										\
+			}																				\
+		};																					\
+	}
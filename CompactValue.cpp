@@ -0,0 +1,315 @@
+/*
+ * CompactValue.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "CompactValue.hpp"
+#include "NumberParser.hpp"
+
+#include <cassert>
+#include <iostream>
+
+using namespace MJSON;
+
+using e_tag = CompactValue::e_tag;
+using e_token = Enums::e_token;
+
+constexpr std::size_t CompactValue::c_SMALL_STRING_MAX;
+
+CompactValue CompactValue::make_null()
+{
+	return CompactValue();
+}
+
+CompactValue CompactValue::make_bool(bool b)
+{
+	CompactValue value;
+	value.m_tag = e_tag::BOOL;
+	value._set_payload(b);
+	return value;
+}
+
+CompactValue CompactValue::make_int(int64_t i)
+{
+	CompactValue value;
+	value.m_tag = e_tag::INT;
+	value._set_payload(i);
+	return value;
+}
+
+CompactValue CompactValue::make_uint(uint64_t ui)
+{
+	CompactValue value;
+	value.m_tag = e_tag::UINT;
+	value._set_payload(ui);
+	return value;
+}
+
+CompactValue CompactValue::make_float(double f)
+{
+	CompactValue value;
+	value.m_tag = e_tag::FLOAT;
+	value._set_payload(f);
+	return value;
+}
+
+CompactValue CompactValue::make_string(StringRef s, Arena& arena)
+{
+	CompactValue value;
+	if(s.size() <= c_SMALL_STRING_MAX)
+	{
+		value.m_tag = e_tag::SMALL_STRING;
+		if(!s.empty())
+			std::memcpy(value.m_bytes, s.data(), s.size());
+		value.m_bytes[c_SMALL_STRING_MAX] = (char)s.size();
+	}
+	else
+	{
+		char* chars = static_cast<char*>(arena.allocate(s.size(), 1));
+		std::memcpy(chars, s.data(), s.size());
+		value.m_tag = e_tag::STRING;
+		value._set_payload<const char*>(chars);
+		value._set_size((uint32_t)s.size());
+	}
+	return value;
+}
+
+CompactValue CompactValue::make_interned_string(const InternedKey* key)
+{
+	CompactValue value;
+	value.m_tag = e_tag::STRING;
+	value._set_payload<const char*>(key->data());
+	value._set_size(key->m_size);
+	return value;
+}
+
+CompactValue CompactValue::make_vector(const CompactValue* elements, uint32_t size)
+{
+	CompactValue value;
+	value.m_tag = e_tag::VECTOR;
+	value._set_payload(elements);
+	value._set_size(size);
+	return value;
+}
+
+CompactValue CompactValue::make_map(const Member* members, uint32_t size)
+{
+	CompactValue value;
+	value.m_tag = e_tag::MAP;
+	value._set_payload(members);
+	value._set_size(size);
+	return value;
+}
+
+Variant::type CompactValue::get_type() const
+{
+	switch(m_tag)
+	{
+	case e_tag::BOOL: return Variant::type::bool_t;
+	case e_tag::INT:
+	case e_tag::UINT: return Variant::type::int_t;
+	case e_tag::FLOAT: return Variant::type::float_t;
+	case e_tag::SMALL_STRING:
+	case e_tag::STRING: return Variant::type::string_t;
+	case e_tag::VECTOR: return Variant::type::vector_t;
+	case e_tag::MAP: return Variant::type::map_t;
+	default: return Variant::type::null_t;
+	}
+}
+
+StringRef CompactValue::get_string() const
+{
+	if(m_tag == e_tag::SMALL_STRING)
+		return StringRef(m_bytes, (std::size_t)m_bytes[c_SMALL_STRING_MAX]);
+	assert(m_tag == e_tag::STRING && "CompactValue is not a string\n");
+	return StringRef(_get_payload<const char*>(), _get_size());
+}
+
+int CompactValue::size() const
+{
+	return (m_tag == e_tag::VECTOR || m_tag == e_tag::MAP) ? (int)_get_size() : 0;
+}
+
+const CompactValue* CompactValue::operator[](int idx) const
+{
+	assert(m_tag == e_tag::VECTOR && "CompactValue is not a vector\n");
+	assert(idx >= 0 && idx < size() && "Index out of range\n");
+	return _get_payload<const CompactValue*>() + idx;
+}
+
+const CompactValue* CompactValue::find(StringRef key) const
+{
+	assert(m_tag == e_tag::MAP && "CompactValue is not a map\n");
+	const Member* members = _get_payload<const Member*>();
+	const uint32_t num_members = _get_size();
+	for(uint32_t idx = 0; idx < num_members; idx++)
+	{
+		if(members[idx].m_key.get_string() == key)
+			return &members[idx].m_value;
+	}
+	return nullptr;
+}
+
+const CompactValue::Member& CompactValue::get_member(int idx) const
+{
+	assert(m_tag == e_tag::MAP && "CompactValue is not a map\n");
+	assert(idx >= 0 && idx < size() && "Index out of range\n");
+	return _get_payload<const Member*>()[idx];
+}
+
+void CompactValue::print_keys() const
+{
+	std::cout << size() << " keys present in map.\n";
+	for(int idx = 0; idx < size(); idx++)
+	{
+		std::cout << idx << ")" << get_member(idx).m_key.get_string().to_string() << "\n";
+	}
+}
+
+uint32_t CompactValue::_get_size() const
+{
+	uint32_t size;
+	std::memcpy(&size, m_bytes + 8, sizeof(size));
+	return size;
+}
+
+void CompactValue::_set_size(uint32_t size)
+{
+	std::memcpy(m_bytes + 8, &size, sizeof(size));
+}
+
+
+std::shared_ptr<const CompactValue> CompactBuilder::build(TokenList& token_list)
+{
+	std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+	KeyPool key_pool(arena.get()); //only needed while building, the keys it holds live in the arena
+	m_scratch.clear();
+	m_frames.clear();
+	m_root = CompactValue::make_null();
+
+	for(int idx = 0; idx < token_list.size(); idx++)
+	{
+		const Token& token = token_list[idx];
+		switch(token.m_type)
+		{
+		case e_token::OBJECT_START:
+			m_frames.push_back(Frame {m_scratch.size(), true});
+			break;
+		case e_token::ARRAY_START:
+			m_frames.push_back(Frame {m_scratch.size(), false});
+			break;
+		case e_token::OBJECT_END:
+		case e_token::ARRAY_END:
+			assert(!m_frames.empty() && "Container end without a matching start\n");
+			_close_container(*arena);
+			break;
+		case e_token::KEY:
+			_push_value(_make_key(token_list.get_value(token), key_pool, *arena));
+			break;
+		case e_token::STRING:
+			_push_value(CompactValue::make_string(token_list.get_value(token), *arena));
+			break;
+		case e_token::NUMBER:
+			_push_value(_number_to_value(token_list.get_value(token)));
+			break;
+		case e_token::BOOL:
+			_push_value(CompactValue::make_bool(token_list.get_value(token)[0] == 't'));
+			break;
+		case e_token::NULL_VALUE:
+			_push_value(CompactValue::make_null());
+			break;
+		default:
+			assert(false && "Invalid token found, should have been removed by tokeniser.\n");
+			break;
+		}
+	}
+	assert(m_frames.empty() && "A container must not have ended (OBJECT_END or ARRAY_END)\n");
+
+	const CompactValue* root = arena->create<CompactValue>(m_root);
+	return std::shared_ptr<const CompactValue>(arena, root);
+}
+
+//Keys short enough to be inline are copied, longer keys share one interned copy per document
+CompactValue CompactBuilder::_make_key(StringRef key, KeyPool& key_pool, Arena& arena)
+{
+	if(key.size() <= CompactValue::c_SMALL_STRING_MAX)
+		return CompactValue::make_string(key, arena);
+	return CompactValue::make_interned_string(key_pool.intern(key, true));
+}
+
+CompactValue CompactBuilder::_number_to_value(StringRef number)
+{
+	ParsedNumber parsed = NumberParser::parse(number);
+	switch(parsed.m_type)
+	{
+	case Enums::e_number::INT64: return CompactValue::make_int(parsed.m_int64);
+	case Enums::e_number::UINT64: return CompactValue::make_uint(parsed.m_uint64);
+	default: return CompactValue::make_float(parsed.m_double);
+	}
+}
+
+void CompactBuilder::_push_value(const CompactValue& value)
+{
+	assert(!m_frames.empty() && "Root object container not set. Object or Array must be root.\n");
+	m_scratch.push_back(value);
+}
+
+void CompactBuilder::_close_container(Arena& arena)
+{
+	Frame frame = m_frames.back();
+	m_frames.pop_back();
+
+	const std::size_t count = m_scratch.size() - frame.m_scratch_start;
+	const CompactValue* first = m_scratch.data() + frame.m_scratch_start;
+	CompactValue container;
+
+	if(frame.m_is_map)
+	{
+		assert(count % 2 == 0 && "Object key without a value\n");
+		CompactValue::Member* members = nullptr;
+		if(count > 0)
+		{
+			members = static_cast<CompactValue::Member*>(arena.allocate(sizeof(CompactValue) * count, alignof(CompactValue::Member)));
+			std::memcpy(static_cast<void*>(members), first, sizeof(CompactValue) * count); //a Member is a key value pair laid out back to back
+		}
+		container = CompactValue::make_map(members, (uint32_t)(count / 2));
+	}
+	else
+	{
+		CompactValue* elements = nullptr;
+		if(count > 0)
+		{
+			elements = static_cast<CompactValue*>(arena.allocate(sizeof(CompactValue) * count, alignof(CompactValue)));
+			std::memcpy(static_cast<void*>(elements), first, sizeof(CompactValue) * count);
+		}
+		container = CompactValue::make_vector(elements, (uint32_t)count);
+	}
+
+	m_scratch.resize(frame.m_scratch_start);
+	if(m_frames.empty())
+		m_root = container;
+	else
+		m_scratch.push_back(container);
+}
@@ -0,0 +1,143 @@
+/*
+ * CompactValue.hpp
+ * A 16 byte tagged value, offered as a lighter alternative to the Variant tree for documents kept
+ * resident.  Strings of up to 14 characters are stored inline, longer strings and container
+ * contents are held in the document's Arena.  Select it with JSON::set_output(Enums::e_output::COMPACT).
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "Arena.hpp"
+#include "KeyPool.hpp"
+#include "StringRef.hpp"
+#include "TokenList.hpp"
+#include "Variant.hpp"
+
+namespace MJSON
+{
+	class CompactValue
+	{
+	public:
+		struct Member;
+
+		enum class e_tag : uint8_t { NULL_VALUE, BOOL, INT, UINT, FLOAT, SMALL_STRING, STRING, VECTOR, MAP };
+
+		static constexpr std::size_t c_SMALL_STRING_MAX = 14;
+
+		CompactValue() {std::memset(m_bytes, 0, sizeof(m_bytes));}
+
+		static CompactValue make_null();
+		static CompactValue make_bool(bool b);
+		static CompactValue make_int(int64_t i);
+		static CompactValue make_uint(uint64_t ui); //only needed above INT64_MAX
+		static CompactValue make_float(double f);
+		static CompactValue make_string(StringRef s, Arena& arena); //copies into the arena unless small enough to be inline
+		static CompactValue make_interned_string(const InternedKey* key); //refers to the key's characters, no copy
+		static CompactValue make_vector(const CompactValue* elements, uint32_t size);
+		static CompactValue make_map(const Member* members, uint32_t size);
+
+		e_tag get_tag() const {return m_tag;}
+		Variant::type get_type() const; //same type enum as the Variant tree
+
+		bool get_bool() const {return _get_payload<bool>();}
+		int64_t get_int() const {return _get_payload<int64_t>();}
+		uint64_t get_uint() const {return _get_payload<uint64_t>();}
+		double get_float() const {return _get_payload<double>();}
+		StringRef get_string() const;
+
+		//Containers, mirroring VectorVariant and MapVariant.  Lookups return nullptr when missing.
+		int size() const;
+		const CompactValue* operator[](int idx) const;
+		const CompactValue* operator[](const char* key) const {return find(key);}
+		const CompactValue* operator[](const std::string& key) const {return find(key);}
+		const CompactValue* find(StringRef key) const;
+		bool has(StringRef key) const {return find(key) != nullptr;}
+		const CompactValue& get_ref_to_value(StringRef key) const {return *find(key);}
+		const CompactValue& get_ref_to_value(int idx) const {return *(*this)[idx];}
+		const Member& get_member(int idx) const;
+
+		void print_keys() const;
+
+	private:
+		template<typename T>
+		T _get_payload() const
+		{
+			T value;
+			std::memcpy(&value, m_bytes, sizeof(T));
+			return value;
+		}
+
+		template<typename T>
+		void _set_payload(T value)
+		{
+			std::memcpy(m_bytes, &value, sizeof(T));
+		}
+
+		uint32_t _get_size() const;
+		void _set_size(uint32_t size);
+
+		//Bytes 0-7 hold the scalar or pointer payload and 8-11 the size of a string or container.
+		//Inline strings use bytes 0-13 for characters and byte 14 for their length.
+		alignas(8) char m_bytes[15];
+		e_tag m_tag = e_tag::NULL_VALUE;
+	};
+
+	struct CompactValue::Member
+	{
+		CompactValue m_key;
+		CompactValue m_value;
+	};
+
+	static_assert(sizeof(CompactValue) == 16, "CompactValue is expected to be 16 bytes");
+
+	//Builds a CompactValue tree from a TokenList.  Values are gathered on a scratch stack and copied into
+	//one contiguous arena block per container when it closes.
+	class CompactBuilder
+	{
+	public:
+		std::shared_ptr<const CompactValue> build(TokenList& token_list);
+
+	private:
+		struct Frame
+		{
+			std::size_t m_scratch_start;
+			bool m_is_map;
+		};
+
+		CompactValue _make_key(StringRef key, KeyPool& key_pool, Arena& arena);
+		CompactValue _number_to_value(StringRef number);
+		void _push_value(const CompactValue& value);
+		void _close_container(Arena& arena);
+
+		std::vector<CompactValue> m_scratch;
+		std::vector<Frame> m_frames;
+		CompactValue m_root;
+	};
+}
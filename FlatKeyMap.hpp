@@ -0,0 +1,204 @@
+/*
+ * FlatKeyMap.hpp
+ * Flat, insertion ordered map from interned keys, used for the members of MapVariant.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "Arena.hpp"
+#include "KeyPool.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#ifndef MJSON_SSE2
+#define MJSON_SSE2
+#endif
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace MJSON
+{
+	//Members are stored contiguously in the order they were added, so iteration follows the document.
+	//Up to c_LINEAR_MAX members are found by comparing a one byte tag from each key's hash, 16 at a time
+	//with SSE2, then the handle.  Larger maps add an open addressed index of member positions.
+	template<typename Value>
+	class FlatKeyMap
+	{
+	public:
+		using value_type = std::pair<const InternedKey*, Value>;
+		using Entries_t = std::vector<value_type, ArenaAllocator<value_type>>;
+		using iterator = typename Entries_t::iterator;
+		using const_iterator = typename Entries_t::const_iterator;
+
+		static constexpr std::size_t c_LINEAR_MAX = 16;
+
+		explicit FlatKeyMap(Arena* arena = nullptr):
+			m_entries(typename Entries_t::allocator_type(arena)), m_index(Index_t::allocator_type(arena))
+		{
+			std::memset(m_tags, 0, sizeof(m_tags));
+		}
+
+		std::size_t size() const {return m_entries.size();}
+		bool empty() const {return m_entries.empty();}
+
+		iterator begin() {return m_entries.begin();}
+		iterator end() {return m_entries.end();}
+		const_iterator begin() const {return m_entries.begin();}
+		const_iterator end() const {return m_entries.end();}
+
+		iterator find(const InternedKey* key)
+		{
+			std::size_t idx = _find_index(key);
+			return idx < m_entries.size() ? m_entries.begin() + idx : m_entries.end();
+		}
+
+		const_iterator find(const InternedKey* key) const
+		{
+			std::size_t idx = _find_index(key);
+			return idx < m_entries.size() ? m_entries.begin() + idx : m_entries.end();
+		}
+
+		std::size_t count(const InternedKey* key) const {return _find_index(key) < m_entries.size() ? 1 : 0;}
+
+		//Returns the member for key and whether it was added, an existing member is left unchanged
+		std::pair<iterator, bool> emplace(const InternedKey* key, Value value);
+
+	private:
+		using Index_t = std::vector<uint32_t, ArenaAllocator<uint32_t>>;
+
+		static constexpr std::size_t c_INITIAL_CAPACITY = 4;
+
+		static uint8_t _tag(const InternedKey* key) {return (uint8_t)(key->m_hash >> (sizeof(std::size_t) * 8 - 8));} //top byte, 32 or 64 bit
+
+		std::size_t _find_index(const InternedKey* key) const; //m_entries.size() if missing
+		std::size_t _find_linear(const InternedKey* key) const;
+		void _build_index(std::size_t num_slots);
+		void _index_entry(std::size_t entry_idx);
+
+		Entries_t m_entries;
+		Index_t m_index; //entry position + 1 per slot, 0 when empty.  Only built above c_LINEAR_MAX members.
+		uint8_t m_tags[c_LINEAR_MAX]; //hash tags of the first c_LINEAR_MAX members
+	};
+
+	template<typename Value>
+	constexpr std::size_t FlatKeyMap<Value>::c_LINEAR_MAX;
+
+	template<typename Value>
+	constexpr std::size_t FlatKeyMap<Value>::c_INITIAL_CAPACITY;
+
+	template<typename Value>
+	std::pair<typename FlatKeyMap<Value>::iterator, bool> FlatKeyMap<Value>::emplace(const InternedKey* key, Value value)
+	{
+		std::size_t existing = _find_index(key);
+		if(existing < m_entries.size())
+			return std::make_pair(m_entries.begin() + existing, false);
+
+		if(m_entries.capacity() == 0)
+			m_entries.reserve(c_INITIAL_CAPACITY);
+		m_entries.emplace_back(key, value);
+
+		const std::size_t num_entries = m_entries.size();
+		if(num_entries <= c_LINEAR_MAX)
+			m_tags[num_entries - 1] = _tag(key);
+		else if(m_index.empty() || num_entries * 2 > m_index.size()) //kept at most half full
+			_build_index(m_index.empty() ? c_LINEAR_MAX * 4 : m_index.size() * 2);
+		else
+			_index_entry(num_entries - 1);
+		return std::make_pair(m_entries.end() - 1, true);
+	}
+
+	template<typename Value>
+	std::size_t FlatKeyMap<Value>::_find_index(const InternedKey* key) const
+	{
+		if(m_index.empty())
+			return _find_linear(key);
+
+		const std::size_t mask = m_index.size() - 1;
+		for(std::size_t slot = key->m_hash & mask; m_index[slot] != 0; slot = (slot + 1) & mask)
+		{
+			std::size_t entry_idx = m_index[slot] - 1;
+			if(m_entries[entry_idx].first == key)
+				return entry_idx;
+		}
+		return m_entries.size();
+	}
+
+	template<typename Value>
+	std::size_t FlatKeyMap<Value>::_find_linear(const InternedKey* key) const
+	{
+		const std::size_t num_entries = m_entries.size();
+#ifdef MJSON_SSE2
+		__m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_tags));
+		uint32_t matches = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8((char)_tag(key))));
+		matches &= (uint32_t)((1u << num_entries) - 1); //tags past the last member are unused
+		while(matches != 0)
+		{
+#if defined(_MSC_VER)
+			unsigned long idx;
+			_BitScanForward(&idx, matches);
+#else
+			std::size_t idx = (std::size_t)__builtin_ctz(matches);
+#endif
+			if(m_entries[idx].first == key)
+				return idx;
+			matches &= matches - 1;
+		}
+#else
+		const uint8_t tag = _tag(key);
+		for(std::size_t idx = 0; idx < num_entries; idx++)
+		{
+			if(m_tags[idx] == tag && m_entries[idx].first == key)
+				return idx;
+		}
+#endif
+		return num_entries;
+	}
+
+	template<typename Value>
+	void FlatKeyMap<Value>::_build_index(std::size_t num_slots)
+	{
+		m_index.assign(num_slots, 0);
+		for(std::size_t entry_idx = 0; entry_idx < m_entries.size(); entry_idx++)
+			_index_entry(entry_idx);
+	}
+
+	template<typename Value>
+	void FlatKeyMap<Value>::_index_entry(std::size_t entry_idx)
+	{
+		const std::size_t mask = m_index.size() - 1;
+		std::size_t slot = m_entries[entry_idx].first->m_hash & mask;
+		while(m_index[slot] != 0)
+			slot = (slot + 1) & mask;
+		m_index[slot] = (uint32_t)(entry_idx + 1);
+	}
+}
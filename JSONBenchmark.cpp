@@ -0,0 +1,401 @@
+/*
+ * JSONBenchmark.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+#include "JSONBenchmark.hpp"
+#include "MJSON.hpp"
+#include "Tokeniser.hpp"
+#include "NDJSONReader.hpp"
+#include "Parser.hpp"
+#include "SaxReader.hpp"
+#include "Writer.hpp"
+#include "Path.hpp"
+#include "Binding.hpp"
+#include "ParallelParser.hpp"
+#include "ThreadPool.hpp"
+#include "ParserContext.hpp"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <algorithm>
+
+using namespace MJSON;
+
+constexpr std::size_t JSONBenchmark::c_CHUNK_SIZE;
+
+//Generates a record oriented document similar to a level file (an array of entities) and reports
+//throughput in MB/s for each stage of the library.  Like the JSONTestParser this is optional and
+//only needs to be run when changing the tokeniser or parser.
+
+//The records written by _generate_record, read with Binding rather than through a Variant tree
+struct BenchTransform
+{
+	std::array<float, 3> m_position;
+	std::array<float, 3> m_scale;
+};
+
+struct BenchEntity
+{
+	std::string m_name;
+	int m_id;
+	bool m_active;
+	BenchTransform m_transform;
+	std::vector<std::string> m_tags;
+};
+
+MJSON_BIND(BenchTransform, MJSON_FIELD(m_position), MJSON_FIELD(m_scale))
+MJSON_BIND(BenchEntity, MJSON_FIELD_AS("name", m_name), MJSON_FIELD_AS("id", m_id), MJSON_FIELD_AS("active", m_active),
+		MJSON_FIELD_AS("transform", m_transform), MJSON_FIELD_AS("tags", m_tags))
+
+//Sums every id, the kind of aggregate the SaxReader is intended for
+struct SumIdsHandler : public SaxHandler
+{
+	void on_key(StringRef key) {m_next_is_id = key == "id";}
+	void on_int(int64_t i) {if(m_next_is_id) m_sum += i;}
+
+	bool m_next_is_id = false;
+	int64_t m_sum = 0;
+};
+
+void JSONBenchmark::run_benchmarks()
+{
+	std::string src = _generate_src(20000);
+	std::cout << "\nJSONBenchmark::run_benchmarks: " << src.size() / 1024 << " KB test document\n";
+	const double bytes = (double)src.size();
+
+	_report("Tokeniser::get_token_list", bytes, _best_of([&]()
+	{
+		Tokeniser t;
+		TokenList tokens = t.get_token_list(src);
+	}));
+
+	for(std::size_t num_threads : {(std::size_t)2, (std::size_t)0})
+	{
+		ThreadPool thread_pool(num_threads);
+		std::string name = "Tokeniser::get_token_list (" + std::to_string(thread_pool.get_thread_count()) + " threads)";
+		_report(name.c_str(), bytes, _best_of([&]()
+		{
+			Tokeniser t;
+			t.set_thread_pool(&thread_pool);
+			TokenList tokens = t.get_token_list(src);
+		}));
+	}
+
+	Tokeniser tokeniser;
+	TokenList token_list = tokeniser.get_token_list(src);
+	_report("Parser::parse_tokens", bytes, _best_of([&]()
+	{
+		Parser p;
+		p.parse_tokens(token_list);
+	}));
+
+	_report("SaxReader::parse (summing ids)", bytes, _best_of([&]()
+	{
+		SaxReader reader;
+		SumIdsHandler handler;
+		reader.parse(src, handler);
+	}));
+
+	_report("JSON::load_src_from_string", bytes, _best_of([&]()
+	{
+		JSON j;
+		j.load_src_from_string(src);
+	}));
+
+	_report("JSON::load_src_from_string (single pass)", bytes, _best_of([&]()
+	{
+		JSON j;
+		j.set_parse_mode(Enums::e_parse_mode::SINGLE_PASS);
+		j.load_src_from_string(src);
+	}));
+
+	Projection projection; //three fields of each record
+	projection.add_pointer("/id").add_pointer("/name").add_pointer("/transform/m_position");
+	_report("JSON::load_src_from_string (projected, 3 fields)", bytes, _best_of([&]()
+	{
+		JSON j;
+		j.load_src_from_string(src, projection);
+	}));
+
+	for(std::size_t num_threads : {(std::size_t)2, (std::size_t)0})
+	{
+		ParallelParser parser(num_threads);
+		std::string name = "ParallelParser::parse (" + std::to_string(parser.get_thread_count()) + " threads)";
+		_report(name.c_str(), bytes, _best_of([&]()
+		{
+			parser.parse(src.data(), src.size());
+		}));
+	}
+
+	_report("PushParser::feed (64 KB chunks)", bytes, _best_of([&]()
+	{
+		PushParser parser;
+		for(std::size_t offset = 0; offset < src.size(); offset += c_CHUNK_SIZE)
+			parser.feed(src.data() + offset, std::min(c_CHUNK_SIZE, src.size() - offset));
+		parser.finish();
+	}));
+
+	std::vector<BenchEntity> entities;
+	_report("read_json (bound structs)", bytes, _best_of([&]()
+	{
+		read_json(src, entities);
+	}));
+
+	_report("JSON::load_src_from_string (compact output)", bytes, _best_of([&]()
+	{
+		JSON j;
+		j.set_output(Enums::e_output::COMPACT);
+		j.load_src_from_string(src);
+	}));
+
+	//Reading the last record is the worst case, every record before it must be skipped
+	_report("JSON::load_src_from_string (lazy output, last record read)", bytes, _best_of([&]()
+	{
+		JSON j;
+		j.set_output(Enums::e_output::LAZY);
+		j.load_src_from_string(src);
+		LazyValue root = j.get_lazy_json();
+		StringRef name = root[19999]["name"].get_string();
+		(void)name;
+	}));
+
+	//Reads that skip large containers, with and without a SkipIndex (its build time is included)
+	std::string wrapped_src = "{\"records\" : " + src + ", \"footer\" : {\"count\" : 20000}}";
+	for(bool build : {false, true})
+	{
+		std::string name = std::string("JSON::load_src_from_string (lazy output, 100 records read") + (build ? ", skip index)" : ")");
+		_report(name.c_str(), bytes, _best_of([&]()
+		{
+			JSON j;
+			j.set_output(Enums::e_output::LAZY);
+			j.set_build_skip_index(build);
+			j.load_src_from_string(src);
+			LazyValue root = j.get_lazy_json();
+			for(int idx = 0; idx < 20000; idx += 200)
+				assert(root[idx]["transform"]["m_scale"].get_raw().size() > 0);
+		}));
+
+		Projection footer;
+		footer.add_pointer("/footer/count");
+		name = std::string("JSON::load_src_from_string (projected, nested records skipped") + (build ? ", skip index)" : ")");
+		_report(name.c_str(), (double)wrapped_src.size(), _best_of([&]()
+		{
+			JSON j;
+			j.set_build_skip_index(build);
+			j.load_src_from_string(wrapped_src, footer);
+		}));
+	}
+
+	std::string mesh_src = _generate_mesh_src(100000);
+	_report("JSON::load_src_from_string (number heavy mesh)", (double)mesh_src.size(), _best_of([&]()
+	{
+		JSON j;
+		j.load_src_from_string(mesh_src);
+	}));
+
+	//Output throughput is measured against the size of the JSON written
+	JSON parsed;
+	parsed.load_src_from_string(src);
+	//The same two paths read from every record, compiled once against parsed for each read
+	VectorVariant& records = *static_cast<VectorVariant*>(parsed.get_parsed_json().get());
+	Path position_x = Path::from_dotted("transform.m_position[0]");
+	Path name_path = Path::from_pointer("/name");
+	_report("Path::evaluate (compiled, 2 paths per record)", bytes, _best_of([&]()
+	{
+		int found = 0;
+		for(int idx = 0; idx < records.size(); idx++)
+			found += (position_x.evaluate(records[idx]) != nullptr) + (name_path.evaluate(records[idx]) != nullptr);
+		assert(found == records.size() * 2);
+	}));
+
+	_report("MapVariant::get (runtime hashed keys)", bytes, _best_of([&]()
+	{
+		int found = 0;
+		for(int idx = 0; idx < records.size(); idx++)
+		{
+			MapVariant* transform = records.get<MapVariant>(idx)->get<MapVariant>("transform");
+			found += transform->has("m_position") + transform->has("m_scale");
+		}
+		assert(found == records.size() * 2);
+	}));
+
+	static constexpr StaticKey c_TRANSFORM("transform");
+	static constexpr StaticKey c_POSITION("m_position");
+	static constexpr StaticKey c_SCALE("m_scale");
+	_report("MapVariant::get (StaticKey)", bytes, _best_of([&]()
+	{
+		int found = 0;
+		for(int idx = 0; idx < records.size(); idx++)
+		{
+			MapVariant* transform = records.get<MapVariant>(idx)->get<MapVariant>(c_TRANSFORM);
+			found += transform->has(c_POSITION) + transform->has(c_SCALE);
+		}
+		assert(found == records.size() * 2);
+	}));
+
+	_report("Path::evaluate (compiled per read, 2 paths per record)", bytes, _best_of([&]()
+	{
+		int found = 0;
+		for(int idx = 0; idx < records.size(); idx++)
+			found += (Path::from_dotted("transform.m_position[0]").evaluate(records[idx]) != nullptr) + (Path::from_pointer("/name").evaluate(records[idx]) != nullptr);
+		assert(found == records.size() * 2);
+	}));
+
+	Writer writer;
+	for(bool pretty : {false, true})
+	{
+		writer.set_pretty(pretty);
+		double seconds = _best_of([&]()
+		{
+			writer.clear();
+			writer.write(*parsed.get_parsed_json());
+		});
+		_report(pretty ? "Writer::write (pretty)" : "Writer::write", (double)writer.get_output().size(), seconds);
+	}
+
+	writer.set_pretty(false);
+	double stream_seconds = _best_of([&]()
+	{
+		writer.clear();
+		writer.start_array();
+		for(int i = 0; i < 20000; i++)
+		{
+			writer.start_object();
+			writer.write_key("name");
+			writer.write_string("entity");
+			writer.write_key("id");
+			writer.write_int(i);
+			writer.write_key("active");
+			writer.write_bool(true);
+			writer.write_key("m_position");
+			writer.start_array();
+			writer.write_double(i + 0.5);
+			writer.write_double(-12.25);
+			writer.write_double(3.0);
+			writer.end_array();
+			writer.end_object();
+		}
+		writer.end_array();
+	});
+	_report("Writer streaming API", (double)writer.get_output().size(), stream_seconds);
+
+	std::string ndjson_src = _generate_ndjson_src(20000);
+	const double ndjson_bytes = (double)ndjson_src.size();
+	for(std::size_t num_threads : {(std::size_t)1, (std::size_t)0})
+	{
+		NDJSONReader reader(num_threads);
+		std::string name = "NDJSONReader::load_src_from_string (" + std::to_string(reader.get_thread_count()) + " threads)";
+		_report(name.c_str(), ndjson_bytes, _best_of([&]()
+		{
+			reader.load_src_from_string(ndjson_src);
+		}));
+	}
+
+	//Many small messages, each parsed on its own as a server would receive them
+	std::vector<StringRef> messages = NDJSONReader::split_records(ndjson_src.data(), ndjson_src.size());
+	_report("JSON::load_src_from_string (new JSON per message)", ndjson_bytes, _best_of([&]()
+	{
+		for(const StringRef& message : messages)
+		{
+			JSON j;
+			j.load_src_from_string(message.to_string());
+		}
+	}));
+
+	ParserContext context;
+	_report("ParserContext::parse (per message)", ndjson_bytes, _best_of([&]()
+	{
+		for(const StringRef& message : messages)
+			context.parse(message);
+	}));
+}
+
+//Runs a benchmark several times and keeps the fastest, so first touch page faults and other noise are excluded
+double JSONBenchmark::_best_of(const std::function<void()>& benchmark)
+{
+	using clock = std::chrono::steady_clock;
+	double best = 0.0;
+	for(int run = 0; run < c_RUNS; run++)
+	{
+		auto start = clock::now();
+		benchmark();
+		std::chrono::duration<double> elapsed = clock::now() - start;
+		if(run == 0 || elapsed.count() < best)
+			best = elapsed.count();
+	}
+	return best;
+}
+
+std::string JSONBenchmark::_generate_src(int num_records)
+{
+	std::string src = "[\n";
+	for(int i = 0; i < num_records; i++)
+	{
+		src += "  " + _generate_record(i);
+		src += (i + 1 < num_records) ? ",\n" : "\n";
+	}
+	src += "]\n";
+	return src;
+}
+
+std::string JSONBenchmark::_generate_ndjson_src(int num_records)
+{
+	std::string src;
+	for(int i = 0; i < num_records; i++)
+	{
+		src += _generate_record(i) + "\n";
+	}
+	return src;
+}
+
+//Vertex positions, normals and indices, similar to exported mesh or animation data
+std::string JSONBenchmark::_generate_mesh_src(int num_vertices)
+{
+	std::string positions;
+	std::string normals;
+	std::string indices;
+	for(int i = 0; i < num_vertices; i++)
+	{
+		std::string separator = i > 0 ? ", " : "";
+		positions += separator + std::to_string(i * 0.013) + ", " + std::to_string(-i * 0.5) + ", " + std::to_string(i % 977) + ".25";
+		normals += separator + "0.5773502691896258, -0.5773502691896258, 5.773502691896258e-1";
+		indices += separator + std::to_string(i * 3) + ", " + std::to_string(i * 3 + 1) + ", " + std::to_string(i * 3 + 2);
+	}
+	return "{\"positions\" : [" + positions + "],\n\"normals\" : [" + normals + "],\n\"indices\" : [" + indices + "]}\n";
+}
+
+std::string JSONBenchmark::_generate_record(int i)
+{
+	std::string idx = std::to_string(i);
+	std::string record = "{\"name\" : \"entity_" + idx + "\", \"id\" : " + idx + ", \"active\" : true, \"parent\" : null,";
+	record += " \"transform\" : { \"m_position\" : [" + idx + ".5, -12.25, 3.0], \"m_scale\" : [1, 1, 1] },";
+	record += " \"tags\" : [\"static\", \"prefab\"] }";
+	return record;
+}
+
+void JSONBenchmark::_report(const char* name, double bytes, double seconds)
+{
+	std::cout << name << ": " << seconds * 1000.0 << " ms, " << (bytes / (1024.0 * 1024.0)) / seconds << " MB/s\n";
+}
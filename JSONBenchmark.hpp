@@ -0,0 +1,53 @@
+/*
+ * JSONBenchmark.hpp
+ * See the cpp file for notes.
+ *
+ *  Created on: 18 Oct 2026
+ *
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <string>
+#include <functional>
+
+namespace MJSON
+{
+class JSONBenchmark
+{
+public:
+	void run_benchmarks();
+
+private:
+	static constexpr int c_RUNS = 5;
+	static constexpr std::size_t c_CHUNK_SIZE = 64 * 1024;
+
+	double _best_of(const std::function<void()>& benchmark);
+	std::string _generate_src(int num_records);
+	std::string _generate_ndjson_src(int num_records);
+	std::string _generate_mesh_src(int num_vertices);
+	std::string _generate_record(int i);
+	void _report(const char* name, double bytes, double seconds);
+};
+
+}
@@ -26,8 +26,27 @@
  */
 #include "JSONTestParser.hpp"
 #include "MJSON.hpp"
+#include "StructuralIndex.hpp"
+#include "Tokeniser.hpp"
+#include "ThreadPool.hpp"
+#include "SkipIndex.hpp"
+#include "PushParser.hpp"
+#include "NDJSONReader.hpp"
+#include "SaxReader.hpp"
+#include "Writer.hpp"
+#include "Path.hpp"
+#include "Binding.hpp"
+#include "ParallelParser.hpp"
+#include "SinglePassParser.hpp"
+#include "ParserContext.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <cassert>
+#include <array>
+#include <thread>
+#include <clocale>
 
 using namespace MJSON;
 
@@ -62,10 +81,35 @@ void JSONTestParser::test_parser()//Function to be used like a unit test
 {
 	JSON j;
 	j.load_src_from_string(test_json_src);
-	auto parsed_json = j.get_parsed_json();
+	std::cout << "\nJSONTestParser::test_parser: Validating JSON test file...\n";
+	_validate_test_json(j.get_parsed_json());
+
+	_test_single_pass();
+	_test_push_parser();
+	_test_ndjson_reader();
+	_test_structural_index();
+	_test_compact_value();
+	_test_lazy_value();
+	_test_sax_reader();
+	_test_writer();
+	_test_numbers();
+	_test_key_pool();
+	_test_map_order();
+	_test_lookups();
+	_test_paths();
+	_test_binding();
+	_test_projection();
+	_test_skip_index();
+	_test_parallel_parser();
+	_test_parallel_tokeniser();
+	_test_concurrent_parsers();
+	_test_parser_context();
+}
 
+//Checks a Variant tree parsed from test_json_src, whichever parse mode produced it
+void JSONTestParser::_validate_test_json(std::shared_ptr<ContainerVariant> parsed_json)
+{
 	constexpr int expected_map_size = 15;
-	std::cout << "\nJSONTestParser::test_parser: Validating JSON test file...\n";
 	assert(parsed_json != nullptr && "Parsed JSON is null. Have you loaded and parsed the source?\n");
 	assert(parsed_json->m_type == Variant::type::map_t && "Expected a map (JSON object) as root.\n");
 
@@ -188,3 +232,938 @@ void JSONTestParser::test_parser()//Function to be used like a unit test
 	}
 	std::cout << "JSON parse test successful. Data types, value and structure as expected.\n\n";
 }
+
+void JSONTestParser::_test_single_pass()
+{
+	JSON j;
+	j.set_parse_mode(Enums::e_parse_mode::SINGLE_PASS);
+	j.load_src_from_string(test_json_src);
+	std::cout << "JSONTestParser::_test_single_pass: Validating single pass parse of JSON test file...\n";
+	_validate_test_json(j.get_parsed_json());
+}
+
+//Feeds the test file in chunks of varying size, so every kind of value gets split across a chunk boundary
+void JSONTestParser::_test_push_parser()
+{
+	std::cout << "JSONTestParser::_test_push_parser: Validating chunked parse of JSON test file...\n";
+	PushParser parser;
+	for(std::size_t chunk_size : {1, 7, 64})
+	{
+		for(std::size_t offset = 0; offset < test_json_src.size(); offset += chunk_size)
+		{
+			parser.feed(test_json_src.data() + offset, std::min(chunk_size, test_json_src.size() - offset));
+		}
+		_validate_test_json(parser.finish());
+	}
+
+	parser.feed("[\"esc\\");
+	parser.feed("\"aped\", 12");
+	parser.feed("34, tr");
+	parser.feed("ue]");
+	auto split_json = parser.finish();
+	VectorVariant& split = *dynamic_cast<VectorVariant*>(split_json.get());
+	assert(split.size() == 3);
+	assert(split[0]->m_string == "esc\\\"aped");
+	assert(split[1]->m_signed_int == 1234);
+	assert(split[2]->m_bool == true);
+}
+
+void JSONTestParser::_test_ndjson_reader()
+{
+	std::cout << "JSONTestParser::_test_ndjson_reader: Validating JSON lines...\n";
+	std::string ndjson_src;
+	constexpr int num_records = 1000;
+	for(int idx = 0; idx < num_records; idx++)
+	{
+		ndjson_src += "{\"id\" : " + std::to_string(idx) + ", \"tags\" : [\"a\", \"b\"]}\n";
+		if(idx % 100 == 0)
+			ndjson_src += "  \n"; //blank lines are skipped
+	}
+
+	NDJSONReader reader(4);
+	auto records = reader.load_src_from_string(ndjson_src);
+	assert(records.size() == num_records && "Record count does not match line count\n");
+	for(int idx = 0; idx < num_records; idx++)
+	{
+		MapVariant& record = *dynamic_cast<MapVariant*>(records[idx].get());
+		assert(record["id"]->m_signed_int == idx && "Records out of order\n");
+		assert(record.get_ref_to_value<VectorVariant>("tags").size() == 2);
+	}
+	std::cout << "JSON lines parsed in order.\n\n";
+}
+
+//Every SIMD kernel supported by this cpu must find the same positions as the scalar one.
+void JSONTestParser::_test_structural_index()
+{
+	using e_implementation = StructuralIndex::e_implementation;
+	std::cout << "JSONTestParser::_test_structural_index: Comparing structural index kernels...\n";
+
+	std::string escaped_src = R"({"quote \" [inside]" : "back\\", "n" : [-1.5e3,true]})";
+	std::array<std::string, 2> sources = { test_json_src, escaped_src };
+
+	StructuralIndex scalar_index;
+	scalar_index.set_implementation(e_implementation::SCALAR);
+	scalar_index.build(escaped_src.data(), escaped_src.size());
+	std::array<uint32_t, 13> expected_positions = { 0, 1, 21, 23, 31, 33, 37, 39, 40, 46, 47, 51, 52 };
+	assert(scalar_index.size() == expected_positions.size() && "Escaped quote or backslash not handled\n");
+	for(std::size_t idx = 0; idx < expected_positions.size(); idx++)
+		assert(scalar_index[idx] == expected_positions[idx]);
+
+	for(auto& src : sources)
+	{
+		scalar_index.build(src.data(), src.size());
+		for(int impl = (int)e_implementation::SSE2; impl <= (int)StructuralIndex::get_implementation(); impl++)
+		{
+			StructuralIndex simd_index;
+			simd_index.set_implementation((e_implementation)impl);
+			simd_index.build(src.data(), src.size());
+			assert(simd_index.get_positions() == scalar_index.get_positions() && "SIMD kernel does not match scalar kernel\n");
+		}
+	}
+	std::cout << "Structural index kernels match.\n\n";
+}
+
+void JSONTestParser::_test_compact_value()
+{
+	std::cout << "JSONTestParser::_test_compact_value: Validating compact output...\n";
+	JSON j;
+	j.set_output(Enums::e_output::COMPACT);
+	j.load_src_from_string(test_json_src);
+	assert(j.get_parsed_json() == nullptr && "Variant tree should not be built for compact output\n");
+	auto compact_json = j.get_compact_json();
+	assert(compact_json != nullptr);
+
+	const CompactValue& root = *compact_json;
+	assert(root.get_type() == Variant::type::map_t);
+	assert(root.size() == 15);
+	assert(root["hello"]->get_string() == "world");
+	assert(root["t"]->get_bool() == true);
+	assert(root["f"]->get_bool() == false);
+	assert(root["n"]->get_type() == Variant::type::null_t);
+	assert(root["i"]->get_int() == 123);
+	assert(root["negative"]->get_int() == -30);
+	assert(root["negative_float"]->get_float() < -21.2 && root["negative_float"]->get_float() > -21.3);
+	assert(root["missing"] == nullptr);
+
+	const CompactValue& array0 = root.get_ref_to_value("array0");
+	assert(array0.size() == 3);
+	assert(array0[1]->get_type() == Variant::type::vector_t && array0[1]->size() == 2 && array0[1]->get_ref_to_value(1).get_int() == 4);
+
+	const CompactValue& transform = root.get_ref_to_value("transform");
+	assert(transform.size() == 3 && transform.get_member(0).m_key.get_string() == "m_position");
+	assert(transform["another_string"]->get_string() == "my string");
+	assert(root["object_array"]->get_ref_to_value(1)["name"]->get_string() == "object1");
+
+	const CompactValue& mixed_array = root.get_ref_to_value("mixed_array");
+	assert(mixed_array.size() == 7);
+	assert(mixed_array[2]->get_type() == Variant::type::float_t);
+	assert(mixed_array[6]->get_string() == "a string");
+
+	std::cout << "Compact output matches.\n\n";
+}
+
+void JSONTestParser::_test_lazy_value()
+{
+	std::cout << "JSONTestParser::_test_lazy_value: Validating lazy output...\n";
+	LazyValue root;
+	{
+		JSON j;
+		j.set_output(Enums::e_output::LAZY);
+		j.load_src_from_string(test_json_src);
+		assert(j.get_parsed_json() == nullptr && j.get_compact_json() == nullptr);
+		root = j.get_lazy_json();
+	} //the source must outlive the JSON object
+
+	assert(root.get_type() == Variant::type::map_t);
+	assert(root.size() == 15);
+	assert(root["hello"].get_string() == "world");
+	assert(root["t"].get_bool() == true && root["f"].get_bool() == false);
+	assert(root["n"].get_type() == Variant::type::null_t);
+	assert(root["negative"].get_int() == -30);
+	assert(root["pi"].get_type() == Variant::type::float_t && root["pi"].get_float() > 3.14 && root["pi"].get_float() < 3.15);
+	assert(!root["missing"].is_valid() && !root.has("missing"));
+
+	LazyValue array0 = root["array0"];
+	assert(array0.size() == 3 && array0[1].size() == 2 && array0[1][1].get_int() == 4);
+	assert(!array0[3].is_valid());
+	assert(root["object_array"][1]["name"].get_string() == "object1");
+	assert(root["transform"]["another_string"].get_raw() == "\"my string\"");
+
+	std::array<const char*, 3> transform_keys = {{"m_position", "m_scale", "another_string"}};
+	std::size_t key_idx = 0;
+	for(LazyValue::iterator it = root["transform"].begin(); it != root["transform"].end(); ++it)
+		assert(it.key() == transform_keys[key_idx++]);
+	assert(key_idx == transform_keys.size());
+
+	int null_count = 0;
+	for(LazyValue value : root["null_array"])
+		null_count += value.get_type() == Variant::type::null_t ? 1 : 0;
+	assert(null_count == 4);
+
+	std::shared_ptr<ContainerVariant> mixed_array = root["mixed_array"].materialise();
+	assert(mixed_array->m_type == Variant::type::vector_t);
+	assert(static_cast<VectorVariant*>(mixed_array.get())->get_ref_to_value<StringV>(6) == "a string");
+
+	JSON empty;
+	empty.set_output(Enums::e_output::LAZY);
+	empty.load_src_from_string("{ }");
+	assert(empty.get_lazy_json().size() == 0 && empty.get_lazy_json().begin() == empty.get_lazy_json().end());
+
+	//A truncated container has no entries rather than reading past the end of the source
+	for(const char* truncated : {"[", "{  ", "[\n"})
+	{
+		LazyValue value(std::make_shared<const std::string>(truncated));
+		assert(value.begin() == value.end() && "Truncated container should have no entries\n");
+	}
+
+	std::cout << "Lazy output matches.\n\n";
+}
+
+//Tallies the events seen, and records the keys of the root object
+struct TestSaxHandler : public SaxHandler
+{
+	void on_object_start() {m_depth++; m_objects++;}
+	void on_object_end() {m_depth--;}
+	void on_array_start() {m_depth++; m_arrays++;}
+	void on_array_end() {m_depth--;}
+	void on_key(StringRef key) {if(m_depth == 1) m_root_keys.push_back(key.to_string());}
+	void on_string(StringRef) {m_strings++;}
+	void on_int(int64_t i) {m_int_sum += i;}
+	void on_float(double f) {m_float_sum += f;}
+	void on_bool(bool b) {m_trues += b ? 1 : 0;}
+	void on_null() {m_nulls++;}
+
+	int m_depth = 0;
+	int m_objects = 0;
+	int m_arrays = 0;
+	int m_strings = 0;
+	int m_trues = 0;
+	int m_nulls = 0;
+	int64_t m_int_sum = 0;
+	double m_float_sum = 0.0;
+	std::vector<std::string> m_root_keys;
+};
+
+void JSONTestParser::_test_sax_reader()
+{
+	std::cout << "JSONTestParser::_test_sax_reader: Validating SAX events...\n";
+	SaxReader reader;
+	TestSaxHandler handler;
+	reader.parse(test_json_src, handler);
+
+	assert(handler.m_depth == 0);
+	assert(handler.m_objects == 5 && handler.m_arrays == 8);
+	assert(handler.m_strings == 5 && handler.m_trues == 2 && handler.m_nulls == 5);
+	assert(handler.m_int_sum == 123 - 30 + 10 + 7 + 4 + 2 + 1 - 3);
+	assert(handler.m_float_sum > -21.245 + 3.1416 + 24235.2544 + 3.4 - 6.5 - 0.001);
+	assert(handler.m_float_sum < -21.245 + 3.1416 + 24235.2544 + 3.4 - 6.5 + 0.001);
+	assert(handler.m_root_keys.size() == 15 && handler.m_root_keys.front() == "hello" && handler.m_root_keys.back() == "mixed_array");
+
+	TestSaxHandler nested_handler;
+	reader.parse(std::string(R"([{"a" : [ ]}, {}, "b"])"), nested_handler); //the reader is reused
+	assert(nested_handler.m_objects == 2 && nested_handler.m_arrays == 2 && nested_handler.m_strings == 1);
+
+	std::cout << "SAX events match.\n\n";
+}
+
+void JSONTestParser::_test_writer()
+{
+	std::cout << "JSONTestParser::_test_writer: Writing and reparsing JSON...\n";
+	JSON j;
+	j.load_src_from_string(test_json_src);
+
+	Writer writer;
+	for(bool pretty : {false, true})
+	{
+		writer.clear();
+		writer.set_pretty(pretty);
+		writer.write(*j.get_parsed_json());
+
+		JSON rewritten;
+		rewritten.load_src_from_string(writer.to_string());
+		_validate_test_json(rewritten.get_parsed_json());
+	}
+
+	writer.clear();
+	writer.set_pretty(false);
+	writer.start_object();
+	writer.write_key("text");
+	writer.write_string("a \"quoted\" C:\\path\nwith a line break, long enough to cross a block\x01");
+	writer.write_key("ints");
+	writer.start_array();
+	writer.write_int(0);
+	writer.write_int(-7);
+	writer.write_int(INT64_MIN);
+	writer.write_int(INT64_MAX);
+	writer.end_array();
+	writer.write_key("floats");
+	writer.start_array();
+	writer.write_float(3.1416f);
+	writer.write_double(0.1);
+	writer.write_double(2.0);
+	writer.write_double(1e300);
+	writer.write_double(-0.0);
+	writer.end_array();
+	writer.write_key("empty");
+	writer.start_object();
+	writer.end_object();
+	writer.write_key("b");
+	writer.write_bool(false);
+	writer.write_key("n");
+	writer.write_null();
+	writer.end_object();
+	assert(writer.get_output() == R"({"text":"a \"quoted\" C:\\path\nwith a line break, long enough to cross a block\u0001",)"
+			R"("ints":[0,-7,-9223372036854775808,9223372036854775807],"floats":[3.1416,0.1,2.0,1e+300,-0.0],"empty":{},"b":false,"n":null})");
+
+	//Numbers are written with '.' whatever the locale's decimal point is
+	std::string previous_locale = std::setlocale(LC_NUMERIC, nullptr);
+	for(const char* comma_locale : {"de_DE.UTF-8", "fr_FR.UTF-8", "de_DE", "C"}) //C if no comma locale is installed
+	{
+		if(std::setlocale(LC_NUMERIC, comma_locale) != nullptr)
+			break;
+	}
+	writer.clear();
+	writer.start_array();
+	writer.write_double(1.5e300);
+	writer.write_float(1.25e-20f);
+	writer.end_array();
+	std::setlocale(LC_NUMERIC, previous_locale.c_str());
+	assert(writer.get_output() == "[1.5e+300,1.25e-20]" && "Numbers written in the locale's format\n");
+
+	writer.clear();
+	writer.set_pretty(true, 2);
+	writer.start_object();
+	writer.write_key("a");
+	writer.start_array();
+	writer.write_int(1);
+	writer.write_int(2);
+	writer.end_array();
+	writer.write_key("e");
+	writer.start_array();
+	writer.end_array();
+	writer.end_object();
+	assert(writer.get_output() == "{\n  \"a\": [\n    1,\n    2\n  ],\n  \"e\": []\n}");
+
+	//Strings and keys added in code are escaped, parsed ones are written back unchanged
+	MapVariant built;
+	built.add_variant(Variant::type::string_t, "say \"hi\"\n\\ \x01", "k\"ey");
+	built.add_variant(Variant::type::vector_t, StringRef(), "arr");
+	built.get<VectorVariant>("arr")->add_variant(Variant::type::string_t, "tab\there");
+	writer.clear();
+	writer.set_pretty(false);
+	writer.write(built);
+	assert(writer.get_output() == R"({"k\"ey":"say \"hi\"\n\\ \u0001","arr":["tab\there"]})" && "Strings built in code must be escaped\n");
+	JSON round_trip;
+	round_trip.load_src_from_string(writer.to_string());
+	Writer rewriter;
+	rewriter.write(*round_trip.get_parsed_json());
+	assert(rewriter.get_output() == writer.get_output() && "Parsed strings must be written unchanged\n");
+
+	std::cout << "Written JSON matches.\n\n";
+}
+
+void JSONTestParser::_test_numbers()
+{
+	std::cout << "JSONTestParser::_test_numbers: Validating 64 bit and double numbers...\n";
+	std::string src = R"({"id" : 9007199254740993, "max" : 9223372036854775807, "min" : -9223372036854775808,
+			"unsigned" : 18446744073709551615, "too_big" : 18446744073709551616, "exponent" : 1e3,
+			"negative_exponent" : -2.5E-3, "long_fraction" : 0.30000000000000004, "small" : 0.1, "zero" : 0})";
+
+	for(Enums::e_parse_mode mode : {Enums::e_parse_mode::TOKENISED, Enums::e_parse_mode::SINGLE_PASS})
+	{
+		JSON j;
+		j.set_parse_mode(mode);
+		j.load_src_from_string(src);
+		MapVariant& root = *static_cast<MapVariant*>(j.get_parsed_json().get());
+
+		assert(root.get_ref_to_value<Int>("id").get_int64() == 9007199254740993LL);
+		assert(root.get_ref_to_value<Int>("id").m_signed_int == INT32_MAX);
+		assert(root.get_ref_to_value<Int>("max").get_int64() == INT64_MAX);
+		assert(root.get_ref_to_value<Int>("min").get_int64() == INT64_MIN);
+		assert(root.get_ref_to_value<Int>("unsigned").is_unsigned() && root.get_ref_to_value<Int>("unsigned").get_uint64() == UINT64_MAX);
+		assert(root["too_big"]->m_type == Variant::type::float_t && root.get_ref_to_value<Float>("too_big").get_double() == 18446744073709551616.0);
+		assert(root["exponent"]->m_type == Variant::type::float_t && root.get_ref_to_value<Float>("exponent").get_double() == 1000.0);
+		assert(root.get_ref_to_value<Float>("negative_exponent").get_double() == -2.5e-3);
+		assert(root.get_ref_to_value<Float>("long_fraction").get_double() == 0.1 + 0.2);
+		assert(root.get_ref_to_value<Float>("small").get_double() == 0.1);
+		assert(root["zero"]->m_type == Variant::type::int_t && root.get_ref_to_value<Int>("zero").get_int64() == 0);
+
+		Writer writer;
+		writer.write(root);
+		JSON rewritten;
+		rewritten.load_src_from_string(writer.to_string());
+		MapVariant& rewritten_root = *static_cast<MapVariant*>(rewritten.get_parsed_json().get());
+		assert(rewritten_root.get_ref_to_value<Int>("unsigned").get_uint64() == UINT64_MAX);
+		assert(rewritten_root.get_ref_to_value<Float>("long_fraction").get_double() == 0.1 + 0.2);
+	}
+
+	//Doubles that are exactly representable as floats must still be written at double precision
+	const double float_exact[] = {0.10000000149011612, 3.4028234663852886e38};
+	for(double value : float_exact)
+	{
+		Writer writer;
+		writer.start_array();
+		writer.write_double(value);
+		writer.end_array();
+		JSON parsed;
+		parsed.load_src_from_string(writer.to_string());
+		Writer rewriter;
+		rewriter.write(*parsed.get_parsed_json());
+		JSON reparsed;
+		reparsed.load_src_from_string(rewriter.to_string());
+		assert(static_cast<VectorVariant*>(reparsed.get_parsed_json().get())->get<Float>(0)->get_double() == value && "Float lost precision when written\n");
+	}
+
+	//The fast paths must agree with strtod, including values that need the slow path
+	const char* doubles[] = {"0.0", "-0.5", "123456.789", "1.7976931348623157e308", "4.9e-324", "2.2250738585072014E-308",
+			"9007199254740993.0", "0.1234567890123456789", "12345678901234567890.5", "1e22", "1e23", "-3.14159265358979323846"};
+	for(const char* number : doubles)
+		assert(NumberParser::parse(number).m_double == std::strtod(number, nullptr));
+
+	//The slow path must not follow the process locale, which may use ',' as its decimal point
+	const char* slow_doubles[] = {"0.12345678901234567890123", "1e300", "-2.5e-310"};
+	const double slow_expected[] = {0.12345678901234567890123, 1e300, -2.5e-310};
+	std::string previous_locale = std::setlocale(LC_NUMERIC, nullptr);
+	for(const char* comma_locale : {"de_DE.UTF-8", "fr_FR.UTF-8", "de_DE", "C"}) //C if no comma locale is installed
+	{
+		if(std::setlocale(LC_NUMERIC, comma_locale) != nullptr)
+			break;
+	}
+	for(std::size_t idx = 0; idx < sizeof(slow_doubles) / sizeof(slow_doubles[0]); idx++)
+		assert(NumberParser::parse(slow_doubles[idx]).m_double == slow_expected[idx] && "Slow path depends on the locale\n");
+	std::setlocale(LC_NUMERIC, previous_locale.c_str());
+
+	std::cout << "Numbers match.\n\n";
+}
+
+void JSONTestParser::_test_key_pool()
+{
+	std::cout << "JSONTestParser::_test_key_pool: Validating interned keys...\n";
+	JSON j;
+	j.load_src_from_string(R"([{"name" : "a", "id" : 1}, {"id" : 2, "name" : "b", "nested" : {"name" : "c"}}])");
+	VectorVariant& root = *static_cast<VectorVariant*>(j.get_parsed_json().get());
+	MapVariant& first = root.get_ref_to_value<MapVariant>(0);
+	MapVariant& second = root.get_ref_to_value<MapVariant>(1);
+
+	KeyPool* key_pool = root.get_key_pool();
+	assert(key_pool != nullptr && first.get_key_pool() == key_pool && second.get_ref_to_value<MapVariant>("nested").get_key_pool() == key_pool);
+	assert(key_pool->size() == 3);
+	for(auto& member : first.m_container)
+		assert(second.m_container.count(member.first) == 1); //the same handles, not just equal strings
+
+	const InternedKey* name = key_pool->find("name");
+	assert(name != nullptr && name->get_string() == "name" && name == key_pool->intern("name"));
+	assert(key_pool->find("missing") == nullptr && first["missing"] == nullptr && key_pool->size() == 3);
+	assert(second.get_ref_to_value<StringV>("name") == "b");
+
+	MapVariant heap_map; //built outside of a document, so creates its own pool
+	heap_map.add_variant(Variant::type::int_t, "5", "five");
+	heap_map.add_variant(Variant::type::map_t, StringRef(), "child");
+	heap_map.get_ref_to_value<MapVariant>("child").add_variant(Variant::type::bool_t, "true", "five");
+	assert(heap_map.get_key_pool() != nullptr && heap_map.get_ref_to_value<MapVariant>("child").get_key_pool() == heap_map.get_key_pool());
+	assert(heap_map.get_ref_to_value<Int>("five") == 5 && heap_map.get_key_pool()->size() == 2);
+
+	KeyPool large_pool; //forces the table to grow
+	for(int idx = 0; idx < 1000; idx++)
+		large_pool.intern(std::to_string(idx));
+	assert(large_pool.size() == 1000 && large_pool.find("999")->get_string() == "999" && large_pool.find("1000") == nullptr);
+
+	std::cout << "Interned keys match.\n\n";
+}
+
+void JSONTestParser::_test_map_order()
+{
+	std::cout << "JSONTestParser::_test_map_order: Validating member order and lookups...\n";
+	//Large enough that the map switches from a linear scan to its index
+	std::string src = "{";
+	for(int idx = 0; idx < 40; idx++)
+		src += (idx > 0 ? "," : "") + std::string("\"key_") + std::to_string(39 - idx) + "\":" + std::to_string(idx);
+	src += ",\"small\":{\"z\":1,\"a\":2,\"m\":[true,null]}}";
+
+	JSON j;
+	j.set_parse_mode(Enums::e_parse_mode::SINGLE_PASS);
+	j.load_src_from_string(src);
+	MapVariant& root = *static_cast<MapVariant*>(j.get_parsed_json().get());
+	assert(root.size() == 41);
+
+	int expected = 0;
+	for(auto& member : root.m_container)
+	{
+		if(expected < 40)
+			assert(member.first->get_string() == "key_" + std::to_string(39 - expected) && member.second->m_signed_int == expected);
+		expected++;
+	}
+	for(int idx = 0; idx < 40; idx++)
+		assert(root.get_ref_to_value<Int>("key_" + std::to_string(idx)) == 39 - idx);
+	assert(root["key_40"] == nullptr && root.get_ref_to_value<MapVariant>("small")["m"] != nullptr);
+
+	Writer writer; //members are written in document order, so compact input is reproduced exactly
+	writer.write(root);
+	assert(writer.get_output() == src);
+
+	MapVariant duplicates;
+	duplicates.add_variant(Variant::type::int_t, "1", "a");
+	duplicates.add_variant(Variant::type::int_t, "2", "b");
+	duplicates.add_variant(Variant::type::int_t, "3", "a"); //last value wins, first position is kept
+	assert(duplicates.size() == 2 && duplicates.get_ref_to_value<Int>("a") == 3);
+	assert(duplicates.m_container.begin()->first->get_string() == "a");
+
+	std::cout << "Member order and lookups match.\n\n";
+}
+
+void JSONTestParser::_test_lookups()
+{
+	std::cout << "JSONTestParser::_test_lookups: Validating non-allocating lookups...\n";
+	JSON j;
+	j.load_src_from_string("{\"name\":\"mesh\",\"count\":3,\"scale\":0.5,\"points\":[{\"x\":4},1,[2]]}");
+	MapVariant& root = *static_cast<MapVariant*>(j.get_parsed_json().get());
+	std::size_t pool_size = root.get_key_pool()->size();
+
+	std::string name_key = "name";
+	assert(root.get<StringV>(name_key) != nullptr && root.get<StringV>("name")->m_string == "mesh");
+	assert(root.get<Int>("count")->get_int64() == 3 && root.get<Float>("scale") != nullptr);
+	assert(root.get<Float>("count") == nullptr && root.get<MapVariant>("points") == nullptr && "Wrong type must give nullptr\n");
+
+	//Misses must not insert into the map or intern the key
+	assert(root.find("missing") == nullptr && !root.has(std::string("missing")) && root.get<Int>("missing") == nullptr);
+	assert(root.size() == 4 && root.get_key_pool()->size() == pool_size);
+
+	VectorVariant* points = root.get<VectorVariant>("points");
+	assert(points != nullptr && points->size() == 3);
+	assert(points->get<MapVariant>(0)->get<Int>("x")->m_signed_int == 4);
+	assert(points->get<Int>(1)->m_signed_int == 1 && points->get<VectorVariant>(2)->size() == 1);
+	assert(points->find(3) == nullptr && points->find(-1) == nullptr && points->get<Int>(2) == nullptr);
+
+	const Variant* count = root.find("count");
+	assert(variant_cast<Int>(count) != nullptr && variant_cast<ContainerVariant>(count) == nullptr);
+
+	std::cout << "Lookups match.\n\n";
+}
+
+void JSONTestParser::_test_paths()
+{
+	std::cout << "JSONTestParser::_test_paths: Validating compiled paths...\n";
+	const std::string src = "{\"transform\":{\"m_position\":[1.5,-2,3]},\"a/b\":{\"m~n\":7},\"\":{\"0\":\"zero\"},\"list\":[{\"id\":10},{\"id\":11}]}";
+	JSON j;
+	j.load_src_from_string(src);
+	Variant* root = j.get_parsed_json().get();
+
+	Path x = Path::from_pointer("/transform/m_position/0");
+	assert(x.size() == 3 && x.get<Float>(root) != nullptr && x.get<Float>(root)->m_float == 1.5f);
+	assert(Path::from_dotted("transform.m_position[1]").get<Int>(root)->m_signed_int == -2);
+	assert(Path::from_dotted("transform.m_position.2").get<Int>(root)->m_signed_int == 3);
+	assert(Path::from_dotted("list[1].id").get<Int>(root)->m_signed_int == 11);
+	assert(Path().evaluate(root) == root);
+
+	static constexpr StaticKey c_TRANSFORM("transform");
+	static constexpr StaticKey c_POSITION("m_position");
+	static_assert(c_POSITION.size() == 10 && c_POSITION.hash() == hash_string("m_position", 10), "StaticKey must hash as the runtime keys do\n");
+	MapVariant& map = *static_cast<MapVariant*>(root);
+	assert(map.get<MapVariant>(c_TRANSFORM)->has(c_POSITION) && !map.has(c_POSITION));
+	Path built;
+	built.append_key(c_TRANSFORM).append_key(c_POSITION).append_index(1);
+	assert(built.get<Int>(root)->m_signed_int == -2 && built.to_pointer() == "/transform/m_position/1");
+
+	//RFC 6901 escapes and the empty key
+	Path escaped = Path::from_pointer("/a~1b/m~0n");
+	assert(escaped.get<Int>(root)->m_signed_int == 7 && escaped.to_pointer() == "/a~1b/m~0n");
+	assert(Path::from_pointer("//0").get<StringV>(root)->m_string == "zero");
+
+	//Misses, including indices that are out of range, malformed or used on an object
+	const std::array<const char*, 6> misses = {"/transform/m_position/3", "/transform/m_position/-", "/transform/m_position/01", "/list/id", "/missing/x", "/transform/m_position/0/x"};
+	for(const char* pointer : misses)
+		assert(Path::from_pointer(pointer).evaluate(root) == nullptr && "Path should not match\n");
+	assert(Path::from_dotted("[0]").evaluate(root) == nullptr && Path::from_dotted("transform[0]").evaluate(root) == nullptr);
+
+	//The same path evaluated against each output
+	JSON compact;
+	compact.set_output(Enums::e_output::COMPACT);
+	compact.load_src_from_string(src);
+	const CompactValue* compact_x = x.evaluate(*compact.get_compact_json());
+	assert(compact_x != nullptr && compact_x->get_float() == 1.5);
+	assert(Path::from_dotted("list[1].id").evaluate(*compact.get_compact_json())->get_int() == 11);
+	assert(Path::from_dotted("list[2].id").evaluate(*compact.get_compact_json()) == nullptr);
+
+	std::cout << "Paths match.\n\n";
+}
+
+struct TestTransform
+{
+	std::array<float, 3> m_position = {{0.0f, 0.0f, 0.0f}};
+	std::vector<int> m_scale;
+};
+
+struct TestEntity
+{
+	std::string m_name;
+	int m_id = -1;
+	uint64_t m_big = 0;
+	bool m_active = false;
+	double m_weight = 1.0;
+	TestTransform m_transform;
+	std::vector<std::string> m_tags;
+	std::vector<TestTransform> m_children;
+};
+
+MJSON_BIND(TestTransform, MJSON_FIELD(m_position), MJSON_FIELD(m_scale))
+MJSON_BIND(TestEntity, MJSON_FIELD_AS("name", m_name), MJSON_FIELD_AS("id", m_id), MJSON_FIELD_AS("big", m_big), MJSON_FIELD_AS("active", m_active),
+		MJSON_FIELD_AS("weight", m_weight), MJSON_FIELD_AS("transform", m_transform), MJSON_FIELD_AS("tags", m_tags), MJSON_FIELD_AS("children", m_children))
+
+void JSONTestParser::_test_binding()
+{
+	std::cout << "JSONTestParser::_test_binding: Validating typed reads into structs...\n";
+	//Unknown keys, including nested containers, are skipped and null leaves the default value
+	const std::string src = R"( [
+		{"name" : "player", "id" : 7, "big" : 18446744073709551615, "unknown" : {"a" : [1, {"b" : "]"}]}, "active" : true,
+		 "weight" : null, "transform" : {"m_position" : [1.5, -2, 3e1, 99], "m_scale" : [1, 2]}, "tags" : ["a", "b\"c"],
+		 "children" : [{"m_position" : [1, 2, 3]}, {}]},
+		{"id" : 8}
+	] )";
+
+	std::vector<TestEntity> entities;
+	read_json(src, entities);
+	assert(entities.size() == 2);
+
+	const TestEntity& player = entities[0];
+	assert(player.m_name == "player" && player.m_id == 7 && player.m_big == UINT64_MAX && player.m_active && player.m_weight == 1.0);
+	assert(player.m_transform.m_position[0] == 1.5f && player.m_transform.m_position[1] == -2.0f && player.m_transform.m_position[2] == 30.0f);
+	assert(player.m_transform.m_scale.size() == 2 && player.m_transform.m_scale[1] == 2);
+	assert(player.m_tags.size() == 2 && player.m_tags[1] == "b\\\"c" && "Strings keep their escape sequences\n");
+	assert(player.m_children.size() == 2 && player.m_children[0].m_position[2] == 3.0f && player.m_children[1].m_scale.empty());
+
+	assert(entities[1].m_id == 8 && entities[1].m_name.empty() && entities[1].m_tags.empty());
+
+	//A root object binds the same way
+	TestTransform transform;
+	read_json("{\"m_scale\" : [4]}", transform);
+	assert(transform.m_scale.size() == 1 && transform.m_scale[0] == 4 && transform.m_position[0] == 0.0f);
+
+	std::cout << "Typed reads match.\n\n";
+}
+
+void JSONTestParser::_test_projection()
+{
+	std::cout << "JSONTestParser::_test_projection: Validating projected parsing...\n";
+	const std::string src = R"( [
+		{"name" : "a", "id" : 1, "transform" : {"m_position" : [1, 2, 3], "m_scale" : [1, 1, 1]}, "tags" : ["x", {"name" : "ignored"}]},
+		{"id" : 2, "transform" : 5, "extra" : {"name" : "nested"}},
+		[{"name" : "b", "unused" : [[1], {"}" : "]"}]}, 7]
+	] )";
+
+	Projection projection;
+	projection.add_pointer("/name").add_dotted("transform.m_position").add_pointer("/transform/m_position/0");
+	JSON j;
+	j.load_src_from_string(src, projection);
+	VectorVariant& root = *static_cast<VectorVariant*>(j.get_parsed_json().get());
+	assert(root.size() == 3);
+
+	//Only the requested members are created, a longer path below a kept member changes nothing
+	MapVariant& first = *root.get<MapVariant>(0);
+	assert(first.size() == 2 && first.get<StringV>("name")->m_string == "a" && !first.has("id") && !first.has("tags"));
+	assert(first.get<MapVariant>("transform")->size() == 1 && first.get<MapVariant>("transform")->get<VectorVariant>("m_position")->size() == 3);
+
+	//A scalar where the path continues beneath it is dropped, as are unrequested nested keys with a requested name
+	assert(root.get<MapVariant>(1)->size() == 0);
+
+	//Arrays don't consume a step, scalar elements of a filtered array are dropped
+	VectorVariant& nested = *root.get<VectorVariant>(2);
+	assert(nested.size() == 1 && nested.get<MapVariant>(0)->size() == 1 && nested.get<MapVariant>(0)->get<StringV>("name")->m_string == "b");
+
+	//Index steps are skipped rather than matched as keys, so every element of the array is filtered alike
+	Projection indexed;
+	indexed.add_dotted("tags[1].name").add(Path().append_key("transform").append_key("m_scale").append_index(2));
+	j.load_src_from_string(src, indexed);
+	MapVariant& indexed_first = *static_cast<VectorVariant*>(j.get_parsed_json().get())->get<MapVariant>(0);
+	assert(indexed_first.size() == 2 && indexed_first.get<MapVariant>("transform")->get<VectorVariant>("m_scale")->size() == 3);
+	VectorVariant& tags = *indexed_first.get<VectorVariant>("tags");
+	assert(tags.size() == 1 && tags.get<MapVariant>(0)->get<StringV>("name")->m_string == "ignored" && "Index step should not be used as a key\n");
+
+	//Digit only pointer and dotted steps are indices to Path::evaluate, so are skipped the same way
+	for(const Projection& digit_steps : {Projection().add_pointer("/tags/0/name"), Projection().add_dotted("tags.1.name")})
+	{
+		j.load_src_from_string(src, digit_steps);
+		MapVariant& digit_first = *static_cast<VectorVariant*>(j.get_parsed_json().get())->get<MapVariant>(0);
+		assert(digit_first.size() == 1 && digit_first.get<VectorVariant>("tags")->size() == 1);
+		assert(digit_first.get<VectorVariant>("tags")->get<MapVariant>(0)->get<StringV>("name")->m_string == "ignored" && "Digit step should not be used as a key\n");
+	}
+
+	//A root path keeps everything, as does an empty projection
+	Projection everything;
+	everything.add(Path());
+	j.load_src_from_string(src, everything);
+	assert(j.get_parsed_json()->m_type == Variant::type::vector_t && static_cast<VectorVariant*>(j.get_parsed_json().get())->get<MapVariant>(0)->size() == 4);
+	j.load_src_from_string(src, Projection());
+	assert(static_cast<VectorVariant*>(j.get_parsed_json().get())->get<VectorVariant>(2)->size() == 2);
+
+	std::cout << "Projected parse matches.\n\n";
+}
+
+void JSONTestParser::_test_skip_index()
+{
+	std::cout << "JSONTestParser::_test_skip_index: Validating container skipping...\n";
+	std::string src = R"( {"a" : [1, {"s" : "}]\"{["}, [[], {}]], "big" : {"x" : [)";
+	for(int idx = 0; idx < 200; idx++)
+		src += (idx > 0 ? ", " : "") + std::string("{\"k\" : [") + std::to_string(idx) + ", \"]\"]}"; //spans many 64 byte blocks
+	src += R"(]}, "last" : {"name" : "end"}} )";
+
+	Tokeniser tokeniser;
+	SkipIndex skip_index;
+	tokeniser.get_token_list(src, &skip_index);
+	SkipIndex standalone;
+	standalone.build(src.data(), src.size());
+	assert(skip_index.size() == standalone.size() && skip_index.size() == 409);
+
+	//Every container matches the scanning skip, positions outside a container's first bracket aren't indexed
+	const char* begin = src.data();
+	const char* end = begin + src.size();
+	std::size_t containers = 0;
+	for(const char* cursor = begin; cursor < end; cursor++)
+	{
+		if(*cursor == '"')
+		{
+			cursor = Tokeniser::find_string_end(cursor + 1, end);
+		}
+		else if(*cursor == '{' || *cursor == '[')
+		{
+			assert(skip_index.find_container_end(begin, cursor) == Tokeniser::find_container_end(cursor, end));
+			containers++;
+		}
+	}
+	assert(containers == skip_index.size() && skip_index.find_container_end(begin, begin) == nullptr);
+
+	//Lazy reads and projected parses give the same results with the index
+	for(bool build : {false, true})
+	{
+		JSON j;
+		j.set_output(Enums::e_output::LAZY);
+		j.set_build_skip_index(build);
+		j.load_src_from_string(src);
+		LazyValue root = j.get_lazy_json();
+		assert(root["last"]["name"].get_string() == "end" && root["big"]["x"].size() == 200 && root["big"]["x"][199]["k"][0].get_int() == 199);
+		assert(root["a"][1]["s"].get_raw() == "\"}]\\\"{[\"" && root["big"].get_raw().size() > 2000);
+
+		Projection projection;
+		projection.add_pointer("/last").add_pointer("/a/s");
+		JSON projected;
+		projected.set_build_skip_index(build);
+		projected.load_src_from_string(src, projection);
+		MapVariant& projected_root = *static_cast<MapVariant*>(projected.get_parsed_json().get());
+		assert(projected_root.size() == 2 && projected_root.get<MapVariant>("last")->has("name"));
+		assert(Path::from_pointer("/a/0/s").get<StringV>(&projected_root) != nullptr);
+	}
+
+	std::cout << "Container skips match.\n\n";
+}
+
+void JSONTestParser::_test_parallel_parser()
+{
+	std::cout << "JSONTestParser::_test_parallel_parser: Validating parallel parse of a root array...\n";
+	//Enough elements to be split into several batches, including scalars and strings holding brackets
+	std::string src = "[\n";
+	for(int idx = 0; idx < 4000; idx++)
+	{
+		std::string i = std::to_string(idx);
+		src += idx > 0 ? ",\n" : "";
+		if(idx % 5 == 4)
+			src += i;
+		else if(idx % 5 == 3)
+			src += "[\"],[" + i + "\", [" + i + ", null], {}]";
+		else
+			src += "{\"id\" : " + i + ", \"name\" : \"entity_" + i + "}\", \"transform\" : {\"m_position\" : [" + i + ".5, -1, 2]}, \"tags\" : [true, false]}";
+	}
+	src += "\n]\n";
+
+	SinglePassParser single_pass;
+	std::shared_ptr<ContainerVariant> expected = single_pass.parse(src.data(), src.size());
+	Writer expected_writer;
+	expected_writer.write(*expected);
+
+	ParallelParser parallel(4); //threads are used even on a single core machine
+	assert(parallel.get_thread_count() == 4);
+	std::shared_ptr<ContainerVariant> parsed = parallel.parse(src.data(), src.size());
+	Writer writer;
+	writer.write(*parsed);
+	assert(writer.get_output() == expected_writer.get_output() && "Parallel parse must match the single pass parse\n");
+
+	//Elements from different batches use their own key pools
+	VectorVariant& root = *static_cast<VectorVariant*>(parsed.get());
+	assert(root.size() == 4000 && root.get<MapVariant>(0)->get<Int>("id")->m_signed_int == 0);
+	assert(root.get<MapVariant>(3995)->get<MapVariant>("transform")->has("m_position") && root.get<Int>(3999)->m_signed_int == 3999);
+	root.get<MapVariant>(3990)->add_variant(Variant::type::int_t, "1", "added"); //allocates from the element's batch arena
+	assert(root.get<MapVariant>(3990)->get<Int>("added") != nullptr);
+
+	//Small documents, objects and empty arrays are parsed on the calling thread
+	for(const char* small : {"[]", " [ 1 ] ", "{\"a\" : [1, 2]}"})
+	{
+		Writer small_writer;
+		small_writer.write(*parallel.parse(small, std::strlen(small)));
+		Writer small_expected;
+		small_expected.write(*single_pass.parse(small, std::strlen(small)));
+		assert(small_writer.get_output() == small_expected.get_output());
+	}
+
+	JSON j;
+	j.set_parse_mode(Enums::e_parse_mode::PARALLEL);
+	j.load_src_from_string(src);
+	assert(static_cast<VectorVariant*>(j.get_parsed_json().get())->size() == 4000);
+	j.set_thread_count(1); //parsed on the calling thread
+	j.load_src_from_string(src);
+	Writer single_thread_writer;
+	single_thread_writer.write(*j.get_parsed_json());
+	assert(single_thread_writer.get_output() == expected_writer.get_output());
+
+	std::cout << "Parallel parse matches.\n\n";
+}
+
+void JSONTestParser::_test_parallel_tokeniser()
+{
+	using e_implementation = StructuralIndex::e_implementation;
+	std::cout << "JSONTestParser::_test_parallel_tokeniser: Comparing chunked scans with single threaded scans...\n";
+	//Varying element lengths move chunk boundaries through strings, escapes, numbers and literals.  The long
+	//string spans whole chunks and holds brackets, quotes and runs of backslashes.
+	std::string src = "[\n";
+	for(int idx = 0; idx < 12000; idx++)
+	{
+		std::string i = std::to_string(idx);
+		src += idx > 0 ? "," : "";
+		if(idx == 6000)
+		{
+			src += "\"";
+			for(int part = 0; part < 20000; part++)
+				src += part % 3 == 0 ? "\\\\\\\"[{" : "x,:}";
+			src += "\"";
+		}
+		else if(idx % 4 == 3)
+			src += "-" + i + ".25e-3";
+		else if(idx % 4 == 2)
+			src += "[\"" + std::string(idx % 7, '\\') + std::string(idx % 7 % 2, '\\') + "\\\"\", null, true]";
+		else
+			src += "{\"key_" + i + "\" : \"" + std::string(idx % 11, 'v') + "\", \"n\":" + i + "}";
+	}
+	src += "\n]\n";
+
+	ThreadPool thread_pool(4); //threads are used even on a single core machine
+	for(int impl = (int)e_implementation::SCALAR; impl <= (int)StructuralIndex::get_implementation(); impl++)
+	{
+		StructuralIndex single_index;
+		single_index.set_implementation((e_implementation)impl);
+		single_index.build(src.data(), src.size());
+		StructuralIndex chunked_index;
+		chunked_index.set_implementation((e_implementation)impl);
+		chunked_index.build(src.data(), src.size(), thread_pool);
+		assert(chunked_index.get_positions() == single_index.get_positions() && "Chunked structural scan does not match\n");
+
+		single_index.build(test_json_src.data(), test_json_src.size());
+		chunked_index.build(test_json_src.data(), test_json_src.size(), thread_pool); //below the chunk size, scanned on this thread
+		assert(chunked_index.get_positions() == single_index.get_positions());
+	}
+
+	Tokeniser single_tokeniser;
+	TokenList single_tokens = single_tokeniser.get_token_list(src);
+	Tokeniser chunked_tokeniser;
+	chunked_tokeniser.set_thread_pool(&thread_pool);
+	TokenList chunked_tokens = chunked_tokeniser.get_token_list(src);
+	assert(chunked_tokens.size() == single_tokens.size() && single_tokens.size() > 50000);
+	for(int idx = 0; idx < single_tokens.size(); idx++)
+	{
+		const Token& expected = single_tokens[idx];
+		const Token& token = chunked_tokens[idx];
+		assert(token.m_offset == expected.m_offset && token.m_length == expected.m_length && token.m_type == expected.m_type && "Chunked tokenising does not match\n");
+	}
+
+	//The token parser expects objects within arrays to follow an array start or another object
+	std::string objects_src = "[";
+	for(int idx = 0; idx < 12000; idx++)
+		objects_src += (idx > 0 ? ",{\"n\" : " : "{\"n\" : ") + std::to_string(idx) + ", \"s\" : \"\\\"]\"}";
+	objects_src += "]";
+	JSON j;
+	j.set_thread_count(4);
+	j.set_parse_mode(Enums::e_parse_mode::TOKENISED);
+	j.load_src_from_string(objects_src);
+	VectorVariant& root = *static_cast<VectorVariant*>(j.get_parsed_json().get());
+	assert(root.size() == 12000 && root.get<MapVariant>(11999)->get<Int>("n")->m_signed_int == 11999);
+
+	std::cout << "Chunked scans match.\n\n";
+}
+
+void JSONTestParser::_test_concurrent_parsers()
+{
+	std::cout << "JSONTestParser::_test_concurrent_parsers: Validating independent parsers on several threads...\n";
+	assert(Enums::e_token_to_string(Enums::e_token::NULL_VALUE) == "NULL_VALUE" && Enums::e_char_to_string(Enums::e_char::COLON) == ":");
+	std::string colon = ":", letter = "a";
+	assert(Enums::e_char_exists(colon) && Enums::string_to_e_char(colon) == Enums::e_char::COLON && !Enums::e_char_exists(letter));
+
+	Writer expected;
+	JSON single;
+	single.load_src_from_string(test_json_src);
+	expected.write(*single.get_parsed_json());
+
+	//Each thread uses its own parsers and only reads the conversion tables
+	std::array<bool, 4> matches {};
+	std::vector<std::thread> threads;
+	for(std::size_t thread_idx = 0; thread_idx < matches.size(); thread_idx++)
+	{
+		threads.emplace_back([&, thread_idx]()
+		{
+			bool match = true;
+			for(int repeat = 0; repeat < 20; repeat++)
+			{
+				JSON j;
+				j.set_parse_mode(repeat % 2 == 0 ? Enums::e_parse_mode::TOKENISED : Enums::e_parse_mode::SINGLE_PASS);
+				j.load_src_from_string(test_json_src);
+				Writer writer;
+				writer.write(*j.get_parsed_json());
+				match = match && writer.get_output() == expected.get_output();
+
+				Tokeniser t;
+				TokenList tokens = t.get_token_list(test_json_src);
+				match = match && tokens[0].to_string(test_json_src.c_str()) == "Token{OBJECT_START,}";
+			}
+			matches[thread_idx] = match;
+		});
+	}
+	for(std::thread& thread : threads)
+		thread.join();
+	for(bool match : matches)
+		assert(match && "Concurrent parse does not match\n");
+
+	std::cout << "Concurrent parsers match.\n\n";
+}
+
+void JSONTestParser::_test_parser_context()
+{
+	std::cout << "JSONTestParser::_test_parser_context: Validating buffer reuse across documents...\n";
+	ParserContext context;
+	std::shared_ptr<ContainerVariant> parsed = context.parse(test_json_src);
+	_validate_test_json(parsed);
+	const ContainerVariant* first_root = parsed.get();
+	const std::size_t bytes_reserved = context.get_arena_bytes_reserved();
+	parsed = nullptr;
+
+	//Once the previous tree is released its arena is reset, so the new root lands where the old one was
+	for(int repeat = 0; repeat < 10; repeat++)
+	{
+		parsed = context.parse(test_json_src);
+		assert(parsed.get() == first_root && context.get_arena_bytes_reserved() == bytes_reserved && "Arena should be reused\n");
+		parsed = nullptr;
+	}
+
+	//A tree that is still held keeps its arena, the next document gets a new one
+	std::shared_ptr<ContainerVariant> held = context.parse(test_json_src);
+	std::string message = "{\"id\" : 7, \"tags\" : [\"a\", \"b\"]}";
+	std::shared_ptr<ContainerVariant> next = context.parse(message);
+	assert(next.get() != held.get() && static_cast<MapVariant*>(next.get())->get<Int>("id")->m_signed_int == 7);
+	_validate_test_json(held);
+
+	TokenList& tokens = context.tokenise(message.data(), message.size());
+	assert(tokens.size() == 9 && tokens.get_value(tokens[1]) == "id");
+
+	JSON j;
+	for(int repeat = 0; repeat < 3; repeat++)
+	{
+		j.load_src_from_string(test_json_src);
+		_validate_test_json(j.get_parsed_json());
+	}
+
+	std::cout << "Parser context buffers reused.\n\n";
+}
@@ -28,13 +28,39 @@
  */
 
 #pragma once
+#include <memory>
 
 namespace MJSON
 {
+class ContainerVariant;
+
 class JSONTestParser
 {
 public:
 	void test_parser();
+
+private:
+	void _validate_test_json(std::shared_ptr<ContainerVariant> parsed_json);
+	void _test_single_pass();
+	void _test_push_parser();
+	void _test_ndjson_reader();
+	void _test_structural_index();
+	void _test_compact_value();
+	void _test_lazy_value();
+	void _test_sax_reader();
+	void _test_writer();
+	void _test_numbers();
+	void _test_key_pool();
+	void _test_map_order();
+	void _test_lookups();
+	void _test_paths();
+	void _test_binding();
+	void _test_projection();
+	void _test_skip_index();
+	void _test_parallel_parser();
+	void _test_parallel_tokeniser();
+	void _test_concurrent_parsers();
+	void _test_parser_context();
 };
 
 }
@@ -0,0 +1,79 @@
+/*
+ * KeyPool.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "KeyPool.hpp"
+
+#include <cassert>
+#include <cstring>
+
+using namespace MJSON;
+
+constexpr std::size_t KeyPool::c_INITIAL_SLOTS;
+
+KeyPool::KeyPool(Arena* arena):
+	m_own_arena(arena == nullptr ? new Arena() : nullptr),
+	m_arena(arena != nullptr ? arena : m_own_arena.get()),
+	m_slots(c_INITIAL_SLOTS, nullptr, Slots_t::allocator_type(m_arena))
+{}
+
+const InternedKey* KeyPool::intern(StringRef key, bool escaped)
+{
+	const std::size_t hash = key.hash();
+	std::size_t slot = _find_slot(key, hash);
+	if(m_slots[slot] != nullptr)
+		return m_slots[slot];
+
+	InternedKey* interned = static_cast<InternedKey*>(m_arena->allocate(sizeof(InternedKey) + key.size(), alignof(InternedKey)));
+	interned->m_hash = hash;
+	interned->m_size = (uint32_t)key.size();
+	interned->m_escaped = escaped;
+	if(!key.empty())
+		std::memcpy(const_cast<char*>(interned->data()), key.data(), key.size());
+
+	m_slots[slot] = interned;
+	m_count++;
+	if(m_count * 2 > m_slots.size()) //kept at most half full so probes stay short
+		_grow();
+	return interned;
+}
+
+void KeyPool::_grow()
+{
+	Slots_t old_slots(m_slots.size() * 2, nullptr, Slots_t::allocator_type(m_arena));
+	old_slots.swap(m_slots);
+
+	const std::size_t mask = m_slots.size() - 1;
+	for(const InternedKey* interned : old_slots)
+	{
+		if(interned == nullptr)
+			continue;
+		std::size_t slot = interned->m_hash & mask;
+		while(m_slots[slot] != nullptr)
+			slot = (slot + 1) & mask;
+		m_slots[slot] = interned;
+	}
+}
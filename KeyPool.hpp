@@ -0,0 +1,104 @@
+/*
+ * KeyPool.hpp
+ * Stores each distinct object key of a document once.  Maps hold InternedKey handles rather than
+ * their own copies of the key, and compare handles rather than strings.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Arena.hpp"
+#include "StringRef.hpp"
+
+namespace MJSON
+{
+	//The key's characters follow the struct in the same allocation.  Equal keys interned in the same pool
+	//share one InternedKey, so handles can be compared by address.
+	struct InternedKey
+	{
+		std::size_t m_hash;
+		uint32_t m_size;
+		bool m_escaped; //source text with its escape sequences, written back unchanged
+
+		const char* data() const {return reinterpret_cast<const char*>(this + 1);}
+		StringRef get_string() const {return StringRef(data(), m_size);}
+	};
+
+	//Open addressed table of interned keys.  Keys, and the table itself, are allocated from the document's
+	//arena when given one, otherwise from an arena owned by the pool.
+	class KeyPool
+	{
+	public:
+		explicit KeyPool(Arena* arena = nullptr);
+
+		KeyPool(const KeyPool&) = delete;
+		KeyPool& operator=(const KeyPool&) = delete;
+
+		//Adds the key if not already present.  escaped is recorded by whichever call adds the key first.
+		const InternedKey* intern(StringRef key, bool escaped = false);
+		const InternedKey* find(StringRef key) const; //nullptr if the key was never interned, never allocates
+		const InternedKey* find(StringRef key, std::size_t hash) const; //hash must be key.hash()
+
+		std::size_t size() const {return m_count;}
+
+	private:
+		using Slots_t = std::vector<const InternedKey*, ArenaAllocator<const InternedKey*>>;
+
+		static constexpr std::size_t c_INITIAL_SLOTS = 64; //power of two
+
+		std::size_t _find_slot(StringRef key, std::size_t hash) const; //slot holding the key, or the empty slot it belongs in
+		void _grow();
+
+		std::unique_ptr<Arena> m_own_arena;
+		Arena* m_arena;
+		Slots_t m_slots;
+		std::size_t m_count = 0;
+	};
+
+	inline std::size_t KeyPool::_find_slot(StringRef key, std::size_t hash) const
+	{
+		const std::size_t mask = m_slots.size() - 1;
+		for(std::size_t slot = hash & mask; ; slot = (slot + 1) & mask)
+		{
+			const InternedKey* interned = m_slots[slot];
+			if(interned == nullptr || (interned->m_hash == hash && interned->get_string() == key))
+				return slot;
+		}
+	}
+
+	inline const InternedKey* KeyPool::find(StringRef key) const
+	{
+		return m_slots[_find_slot(key, key.hash())];
+	}
+
+	inline const InternedKey* KeyPool::find(StringRef key, std::size_t hash) const
+	{
+		return m_slots[_find_slot(key, hash)];
+	}
+}
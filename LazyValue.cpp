@@ -0,0 +1,216 @@
+/*
+ * LazyValue.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "LazyValue.hpp"
+#include "SinglePassParser.hpp"
+#include "Tokeniser.hpp"
+#include "NumberParser.hpp"
+
+#include <cassert>
+
+using namespace MJSON;
+
+using e_char = Enums::e_char;
+
+namespace
+{
+	inline const char* find_value_end(const std::string& json_src, const SkipIndex* skip_index, const char* cursor, const char* end, std::size_t& hint)
+	{
+		return skip_index != nullptr ? skip_index->find_value_end(json_src.data(), cursor, end, hint) : Tokeniser::find_value_end(cursor, end);
+	}
+
+	inline const char* find_value_end(const std::string& json_src, const SkipIndex* skip_index, const char* cursor, const char* end)
+	{
+		std::size_t hint = 0;
+		return find_value_end(json_src, skip_index, cursor, end, hint);
+	}
+}
+
+LazyValue::LazyValue(std::shared_ptr<const std::string> json_src):
+	LazyValue(std::move(json_src), nullptr)
+{}
+
+LazyValue::LazyValue(std::shared_ptr<const std::string> json_src, const SkipIndex* skip_index):
+	m_json_src(std::move(json_src)), m_skip_index(skip_index)
+{
+	const char* begin = m_json_src->data();
+	m_end = begin + m_json_src->size();
+	m_cursor = Tokeniser::skip_whitespace(begin, m_end);
+	if(m_cursor == m_end)
+		m_cursor = nullptr;
+}
+
+Variant::type LazyValue::get_type() const
+{
+	assert(is_valid() && "LazyValue is not valid\n");
+	switch(Enums::char_to_e_char(*m_cursor))
+	{
+	case e_char::BRACE_OPEN: return Variant::type::map_t;
+	case e_char::BRACKET_OPEN: return Variant::type::vector_t;
+	case e_char::QUOTE: return Variant::type::string_t;
+	case e_char::NUMBER: return NumberParser::is_float(get_raw()) ? Variant::type::float_t : Variant::type::int_t;
+	default: return *m_cursor == 'n' ? Variant::type::null_t : Variant::type::bool_t;
+	}
+}
+
+bool LazyValue::get_bool() const
+{
+	assert(get_type() == Variant::type::bool_t && "LazyValue is not a bool\n");
+	return *m_cursor == 't';
+}
+
+int64_t LazyValue::get_int() const
+{
+	assert(get_type() == Variant::type::int_t && "LazyValue is not an int\n");
+	return NumberParser::parse(get_raw()).to_int64();
+}
+
+uint64_t LazyValue::get_uint() const
+{
+	assert(get_type() == Variant::type::int_t && "LazyValue is not an int\n");
+	ParsedNumber number = NumberParser::parse(get_raw());
+	return number.m_type == Enums::e_number::UINT64 ? number.m_uint64 : (uint64_t)number.m_int64;
+}
+
+double LazyValue::get_float() const
+{
+	assert(Enums::char_to_e_char(*m_cursor) == e_char::NUMBER && "LazyValue is not a number\n");
+	return NumberParser::parse(get_raw()).to_double();
+}
+
+StringRef LazyValue::get_string() const
+{
+	assert(get_type() == Variant::type::string_t && "LazyValue is not a string\n");
+	return StringRef(m_cursor + 1, Tokeniser::find_string_end(m_cursor + 1, m_end));
+}
+
+StringRef LazyValue::get_raw() const
+{
+	assert(is_valid() && "LazyValue is not valid\n");
+	return StringRef(m_cursor, find_value_end(*m_json_src, m_skip_index, m_cursor, m_end));
+}
+
+int LazyValue::size() const
+{
+	int count = 0;
+	for(iterator it = begin(); it != end(); ++it)
+		count++;
+	return count;
+}
+
+LazyValue LazyValue::operator[](int idx) const
+{
+	assert(get_type() == Variant::type::vector_t && "LazyValue is not a vector\n");
+	iterator it = begin();
+	for(; it != end() && idx > 0; ++it)
+		idx--;
+	return it != end() ? it.value() : LazyValue();
+}
+
+LazyValue LazyValue::find(StringRef key) const
+{
+	assert(get_type() == Variant::type::map_t && "LazyValue is not a map\n");
+	for(iterator it = begin(); it != end(); ++it)
+	{
+		if(it.key() == key)
+			return it.value();
+	}
+	return LazyValue();
+}
+
+LazyValue::iterator LazyValue::begin() const
+{
+	const char* entry = _first_entry();
+	return entry != nullptr ? iterator(*this, entry) : iterator();
+}
+
+LazyValue::iterator LazyValue::end() const
+{
+	return iterator();
+}
+
+std::shared_ptr<ContainerVariant> LazyValue::materialise() const
+{
+	assert((get_type() == Variant::type::map_t || get_type() == Variant::type::vector_t) && "Only containers can be materialised\n");
+	SinglePassParser p;
+	return p.parse(m_cursor, find_value_end(*m_json_src, m_skip_index, m_cursor, m_end) - m_cursor);
+}
+
+const char* LazyValue::_first_entry() const
+{
+	if(!is_valid())
+		return nullptr;
+	e_char type = Enums::char_to_e_char(*m_cursor);
+	if(type != e_char::BRACE_OPEN && type != e_char::BRACKET_OPEN)
+		return nullptr;
+
+	const char* entry = Tokeniser::skip_whitespace(m_cursor + 1, m_end);
+	if(entry >= m_end) //truncated source, the container never closes
+		return nullptr;
+	return (*entry == '}' || *entry == ']') ? nullptr : entry;
+}
+
+LazyValue::iterator::iterator(const LazyValue& container, const char* entry):
+	m_json_src(container.m_json_src), m_skip_index(container.m_skip_index), m_end(container.m_end), m_is_map(*container.m_cursor == '{')
+{
+	_read_entry(entry);
+}
+
+LazyValue::iterator& LazyValue::iterator::operator++()
+{
+	const char* end = m_end;
+	const char* cursor = Tokeniser::skip_whitespace(find_value_end(*m_json_src, m_skip_index, m_value, end, m_skip_hint), end);
+	if(cursor < end && *cursor == ',')
+	{
+		_read_entry(Tokeniser::skip_whitespace(cursor + 1, end));
+	}
+	else
+	{
+		assert(cursor < end && (*cursor == '}' || *cursor == ']') && "Expected the container to end\n");
+		m_key = StringRef();
+		m_value = nullptr;
+	}
+	return *this;
+}
+
+void LazyValue::iterator::_read_entry(const char* entry)
+{
+	const char* end = m_end;
+	if(!m_is_map)
+	{
+		m_value = entry;
+		return;
+	}
+
+	assert(*entry == '"' && "Expected a key\n");
+	const char* key_end = Tokeniser::find_string_end(entry + 1, end);
+	m_key = StringRef(entry + 1, key_end);
+
+	const char* colon = Tokeniser::skip_whitespace(key_end + 1, end);
+	assert(colon < end && *colon == ':' && "Expected a colon following the key\n");
+	m_value = Tokeniser::skip_whitespace(colon + 1, end);
+}
@@ -0,0 +1,135 @@
+/*
+ * LazyValue.hpp
+ * A cursor into the JSON source that parses values only when they are read.  Containers are not
+ * scanned until they are indexed, and values that are stepped over are skipped by bracket matching
+ * rather than parsed.  Select it with JSON::set_output(Enums::e_output::LAZY).
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "SkipIndex.hpp"
+#include "StringRef.hpp"
+#include "Variant.hpp"
+
+namespace MJSON
+{
+	//A LazyValue keeps the source alive, so values may be held after the JSON object that loaded them
+	//is gone.  An invalid LazyValue is returned for a missing key or index, check with is_valid().
+	class LazyValue
+	{
+	public:
+		class iterator;
+
+		LazyValue() = default;
+		explicit LazyValue(std::shared_ptr<const std::string> json_src); //the root value of the source
+		LazyValue(std::shared_ptr<const std::string> json_src, const SkipIndex* skip_index); //skip_index must be owned along with json_src
+
+		bool is_valid() const {return m_cursor != nullptr;}
+		explicit operator bool() const {return is_valid();}
+
+		Variant::type get_type() const;
+
+		bool get_bool() const;
+		int64_t get_int() const;
+		uint64_t get_uint() const; //for integers above INT64_MAX
+		double get_float() const;
+		StringRef get_string() const; //characters between the quotes, escapes are left as they are in the source
+		StringRef get_raw() const; //the value's full text in the source
+
+		//Containers, mirroring VectorVariant and MapVariant.  Each call scans the container from its start.
+		int size() const;
+		LazyValue operator[](int idx) const;
+		LazyValue operator[](const char* key) const {return find(key);}
+		LazyValue operator[](const std::string& key) const {return find(key);}
+		LazyValue find(StringRef key) const;
+		bool has(StringRef key) const {return find(key).is_valid();}
+
+		iterator begin() const;
+		iterator end() const;
+
+		//Parses this container into a Variant tree, for when most of it is going to be read
+		std::shared_ptr<ContainerVariant> materialise() const;
+
+	private:
+		LazyValue(const std::shared_ptr<const std::string>& json_src, const SkipIndex* skip_index, const char* cursor, const char* end):
+			m_json_src(json_src), m_skip_index(skip_index), m_cursor(cursor), m_end(end)
+		{}
+
+		const char* _first_entry() const; //first key or element of a container, nullptr if empty
+
+		std::shared_ptr<const std::string> m_json_src;
+		const SkipIndex* m_skip_index = nullptr; //containers are skipped with this when set
+		const char* m_cursor = nullptr;
+		const char* m_end = nullptr;
+	};
+
+	//Steps through the elements of an array or the members of an object.  key() is empty for arrays.
+	class LazyValue::iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = LazyValue;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const LazyValue*;
+		using reference = LazyValue;
+
+		iterator() = default;
+
+		StringRef key() const {return m_key;}
+		LazyValue value() const {return LazyValue(m_json_src, m_skip_index, m_value, m_end);}
+		LazyValue operator*() const {return value();}
+
+		iterator& operator++();
+		iterator operator++(int)
+		{
+			iterator prev = *this;
+			++(*this);
+			return prev;
+		}
+
+		bool operator==(const iterator& other) const {return m_value == other.m_value;}
+		bool operator!=(const iterator& other) const {return m_value != other.m_value;}
+
+	private:
+		friend class LazyValue;
+
+		iterator(const LazyValue& container, const char* entry);
+
+		void _read_entry(const char* entry);
+
+		std::shared_ptr<const std::string> m_json_src;
+		const SkipIndex* m_skip_index = nullptr;
+		std::size_t m_skip_hint = 0; //next sibling container in m_skip_index
+		const char* m_end = nullptr;
+		bool m_is_map = false;
+		StringRef m_key;
+		const char* m_value = nullptr;
+	};
+}
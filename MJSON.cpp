@@ -33,10 +33,22 @@
 
 #include "Tokeniser.hpp"
 #include "Parser.hpp"
+#include "SinglePassParser.hpp"
+#include "ParallelParser.hpp"
 
 
 using namespace MJSON;
 
+namespace
+{
+	//Owns a lazy source along with its skip index, so LazyValues keep both alive through one shared_ptr
+	struct IndexedSource
+	{
+		std::string m_json_src;
+		SkipIndex m_skip_index;
+	};
+}
+
 using e_char = Enums::e_char;
 using e_token = Enums::e_token;
 
@@ -50,25 +62,102 @@ void JSON::load_src(std::string load_path)
 		ss << f.rdbuf();
 	}
 	m_json_src = ss.str();
-	TokenList token_list = _convert_src_to_tokens();
-	_parse_tokens(token_list);
+	_parse_src();
 }
 
 void JSON::load_src_from_string(std::string json_src)
 {
 	m_json_src = json_src;
-	TokenList token_list = _convert_src_to_tokens();
-	_parse_tokens(token_list);
+	_parse_src();
+}
+
+void JSON::load_src(std::string path, const Projection& projection)
+{
+	m_projection = &projection;
+	load_src(std::move(path));
+	m_projection = nullptr;
+}
+
+void JSON::load_src_from_string(std::string json_src, const Projection& projection)
+{
+	m_projection = &projection;
+	load_src_from_string(std::move(json_src));
+	m_projection = nullptr;
+}
+
+void JSON::set_thread_count(std::size_t num_threads)
+{
+	m_thread_count = num_threads;
+	m_tokenise_with_threads = num_threads != 1;
+	m_thread_pool = nullptr; //started with the new count when next needed
 }
 
-TokenList JSON::_convert_src_to_tokens()
+ThreadPool* JSON::_get_thread_pool()
 {
-	Tokeniser t;
-	return t.get_token_list(m_json_src);
+	if(m_thread_count == 1)
+		return nullptr; //everything runs on the calling thread
+	if(m_thread_pool == nullptr)
+		m_thread_pool.reset(new ThreadPool(m_thread_count));
+	return m_thread_pool.get();
 }
 
-void JSON::_parse_tokens(TokenList& token_list)
+void JSON::_parse_src()
 {
-	Parser p;
-	m_parsed_json = p.parse_tokens(token_list);
+	assert((m_projection == nullptr || m_output == Enums::e_output::VARIANT) && "Projections are only supported with Variant output\n");
+	m_lazy_json = LazyValue();
+	if(m_output == Enums::e_output::LAZY)
+	{
+		m_parsed_json = nullptr;
+		m_compact_json = nullptr;
+		if(m_build_skip_index)
+		{
+			std::shared_ptr<IndexedSource> indexed = std::make_shared<IndexedSource>();
+			indexed->m_json_src = std::move(m_json_src);
+			indexed->m_skip_index.build(indexed->m_json_src.data(), indexed->m_json_src.size());
+			m_lazy_json = LazyValue(std::shared_ptr<const std::string>(indexed, &indexed->m_json_src), &indexed->m_skip_index);
+		}
+		else
+		{
+			m_lazy_json = LazyValue(std::make_shared<const std::string>(std::move(m_json_src))); //values share ownership of the source
+		}
+		m_json_src.clear();
+		return;
+	}
+
+	ThreadPool* thread_pool = m_parse_mode == Enums::e_parse_mode::PARALLEL ? _get_thread_pool() : nullptr;
+	if(thread_pool != nullptr && m_projection == nullptr && m_output == Enums::e_output::VARIANT)
+	{
+		m_compact_json = nullptr;
+		ParallelParser p(*thread_pool); //the pool is kept, so loads don't each start and join threads
+		m_parsed_json = p.parse(m_json_src.data(), m_json_src.size());
+		return;
+	}
+
+	if((m_parse_mode != Enums::e_parse_mode::TOKENISED || m_projection != nullptr) && m_output == Enums::e_output::VARIANT)
+	{
+		m_compact_json = nullptr;
+		SinglePassParser p;
+		p.set_projection(m_projection);
+		SkipIndex skip_index;
+		if(m_projection != nullptr && m_build_skip_index)
+		{
+			skip_index.build(m_json_src.data(), m_json_src.size());
+			p.set_skip_index(&skip_index, m_json_src.data());
+		}
+		m_parsed_json = p.parse(m_json_src.data(), m_json_src.size());
+		return;
+	}
+
+	m_parsed_json = nullptr; //releases the previous tree, so the context can reuse its arena
+	m_compact_json = nullptr;
+	m_context.set_thread_pool(m_tokenise_with_threads ? _get_thread_pool() : nullptr);
+	if(m_output == Enums::e_output::COMPACT)
+	{
+		CompactBuilder builder;
+		m_compact_json = builder.build(m_context.tokenise(m_json_src.data(), m_json_src.size()));
+	}
+	else
+	{
+		m_parsed_json = m_context.parse(m_json_src.data(), m_json_src.size());
+	}
 }
@@ -36,6 +36,13 @@
 #include "Variant.hpp"
 #include "Token.hpp"
 #include "TokenList.hpp"
+#include "CompactValue.hpp"
+#include "LazyValue.hpp"
+#include "Path.hpp"
+#include "Projection.hpp"
+#include "PushParser.hpp"
+#include "ParserContext.hpp"
+#include "ThreadPool.hpp"
 
 //typedef std::string::size_type char_idx_t;
 
@@ -45,22 +52,46 @@ namespace MJSON
 	class JSON
 	{
 	public:
-		JSON()
-		{
-			Enums::init_conversions();
-		}
-
+		//Reusing one JSON for many loads keeps its source, token and arena buffers, see ParserContext
 		void load_src(std::string path); //loads json src file into m_json_src member
 		void load_src_from_string(std::string json_src); //sets json_src member to a string of json src
 
+		//Builds a Variant tree of only the members in the projection, parsing in a single pass
+		void load_src(std::string path, const Projection& projection);
+		void load_src_from_string(std::string json_src, const Projection& projection);
+
+		void set_output(Enums::e_output output) {m_output = output;} //choose the tree built by the next load
+		void set_parse_mode(Enums::e_parse_mode mode) {m_parse_mode = mode;} //SINGLE_PASS and PARALLEL only apply to Variant output
+
+		//Lazy output and projected loads first build a SkipIndex of the source, so containers that aren't
+		//read are jumped over rather than scanned.  Worthwhile when large subtrees are skipped.
+		void set_build_skip_index(bool build) {m_build_skip_index = build;}
+
+		//Threads used to index and tokenise large sources, and by the PARALLEL parse mode.  1 keeps the work on
+		//the calling thread, PARALLEL then parses in a single pass.  0 uses one thread per hardware thread.
+		//Without a call, only PARALLEL uses threads.
+		void set_thread_count(std::size_t num_threads);
+
 		std::shared_ptr<ContainerVariant> get_parsed_json() {return m_parsed_json;}
+		std::shared_ptr<const CompactValue> get_compact_json() {return m_compact_json;}
+		LazyValue get_lazy_json() {return m_lazy_json;}
 
 	private:
-		TokenList _convert_src_to_tokens();
-		void _parse_tokens(TokenList&);
+		void _parse_src();
+		ThreadPool* _get_thread_pool();
 
 		std::string m_json_src;
 		std::shared_ptr<ContainerVariant> m_parsed_json = nullptr;
+		std::shared_ptr<const CompactValue> m_compact_json = nullptr;
+		LazyValue m_lazy_json;
+		Enums::e_output m_output = Enums::e_output::VARIANT;
+		Enums::e_parse_mode m_parse_mode = Enums::e_parse_mode::TOKENISED;
+		const Projection* m_projection = nullptr; //only set for the duration of a projected load
+		bool m_build_skip_index = false;
+		std::size_t m_thread_count = 0; //one per hardware thread
+		bool m_tokenise_with_threads = false;
+		std::unique_ptr<ThreadPool> m_thread_pool; //started by the first load that uses it
+		ParserContext m_context; //reused by each tokenised load
 	};
 }
 
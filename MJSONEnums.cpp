@@ -29,64 +29,50 @@
 
 using namespace MJSON;
 
-bool Enums::m_initialised = false;
-std::unordered_map<Enums::e_char, std::string> Enums::m_e_character_to_string;
-std::unordered_map<std::string, Enums::e_char> Enums::m_string_to_character_e;
-std::unordered_map<Enums::e_token, std::string> Enums::m_e_token_to_string;
-
-void Enums::init_conversions()
+namespace
 {
-	if(m_initialised)
-		return;
-	m_initialised = true;
-	m_e_character_to_string[e_char::BRACE_OPEN] = "{";
-	m_e_character_to_string[e_char::BRACE_CLOSE] = "}";
-	m_e_character_to_string[e_char::COLON] = ":";
-	m_e_character_to_string[e_char::COMMA] = ",";
-	m_e_character_to_string[e_char::QUOTE] = "\"";
-	m_e_character_to_string[e_char::BRACKET_OPEN] = "[";
-	m_e_character_to_string[e_char::BRACKET_CLOSE] = "]";
-	m_e_character_to_string[e_char::PERIOD] = ".";
-	m_e_character_to_string[e_char::NEWLINE] = "\n";
-	m_e_character_to_string[e_char::WHITESPACE] = " ";
+	//Indexed by e_char, empty for classes that stand for more than one character
+	constexpr const char* c_CHAR_STRINGS[] = { "{", "}", ":", ",", "\"", "[", "]", "", "", ".", "\n", " ", "" };
+	static_assert(sizeof(c_CHAR_STRINGS) / sizeof(c_CHAR_STRINGS[0]) == (std::size_t)Enums::e_char::INVALID + 1, "One string per e_char\n");
 
+	//Indexed by e_token
+	constexpr const char* c_TOKEN_STRINGS[] = { "NOTHING", "OBJECT_START", "OBJECT_END", "COMMA", "KEY", "COLON", "NUMBER", "BOOL",
+		"STRING", "ARRAY_START", "ARRAY_END", "NULL_VALUE" };
+	static_assert(sizeof(c_TOKEN_STRINGS) / sizeof(c_TOKEN_STRINGS[0]) == (std::size_t)Enums::e_token::NULL_VALUE + 1, "One string per e_token\n");
 
-	for(auto& pair : m_e_character_to_string)
+	bool find_e_char(const std::string& char_string, Enums::e_char& c)
 	{
-		m_string_to_character_e[pair.second] = pair.first;
+		for(std::size_t idx = 0; idx < sizeof(c_CHAR_STRINGS) / sizeof(c_CHAR_STRINGS[0]); idx++)
+		{
+			if(c_CHAR_STRINGS[idx][0] != '\0' && char_string == c_CHAR_STRINGS[idx])
+			{
+				c = (Enums::e_char)idx;
+				return true;
+			}
+		}
+		return false;
 	}
-
-	m_e_token_to_string[e_token::NOTHING] = "NOTHING";
-	m_e_token_to_string[e_token::OBJECT_START] = "OBJECT_START";
-	m_e_token_to_string[e_token::OBJECT_END] = "OBJECT_END";
-	m_e_token_to_string[e_token::COMMA] = "COMMA";
-	m_e_token_to_string[e_token::KEY] = "KEY";
-	m_e_token_to_string[e_token::COLON] = "COLON";
-	m_e_token_to_string[e_token::NUMBER] = "NUMBER";
-	m_e_token_to_string[e_token::BOOL] = "BOOL";
-	m_e_token_to_string[e_token::STRING] = "STRING";
-	m_e_token_to_string[e_token::ARRAY_START] = "ARRAY_START";
-	m_e_token_to_string[e_token::ARRAY_END] = "ARRAY_END";
-	m_e_token_to_string[e_token::NULL_VALUE] = "NULL_VALUE";
-
 }
 
 std::string Enums::e_char_to_string(e_char c)
 {
-	return m_e_character_to_string[c];
+	return c_CHAR_STRINGS[(std::size_t)c];
 }
 
 Enums::e_char Enums::string_to_e_char(std::string& s)
 {
-	return m_string_to_character_e[s];
+	e_char c = e_char::INVALID;
+	find_e_char(s, c);
+	return c;
 }
 
 bool Enums::e_char_exists(std::string& char_string)
 {
-	return m_string_to_character_e.find(char_string) != m_string_to_character_e.end();
+	e_char c;
+	return find_e_char(char_string, c);
 }
 
 std::string Enums::e_token_to_string(e_token token)
 {
-	return m_e_token_to_string[token];
+	return c_TOKEN_STRINGS[(std::size_t)token];
 }
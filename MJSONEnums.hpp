@@ -26,16 +26,16 @@
  */
 
 #pragma once
-#include <unordered_map>
 #include <vector>
 #include <string>
+#include <cstdint>
 
 namespace MJSON
 {
 	class Enums
 	{
 	public:
-		enum class e_char {
+		enum class e_char : uint8_t {
 			BRACE_OPEN,//{
 			BRACE_CLOSE,//}
 			COLON, //:
@@ -47,10 +47,11 @@ namespace MJSON
 			NUMBER,
 			PERIOD,//.
 			NEWLINE,
-			WHITESPACE
+			WHITESPACE, //space, tab or carriage return
+			INVALID //anything that cannot start or delimit a JSON value
 		};
 
-		enum class e_token
+		enum class e_token : uint8_t
 		{
 			NOTHING,
 			OBJECT_START, //{
@@ -66,22 +67,77 @@ namespace MJSON
 			NULL_VALUE // null
 		};
 
-		static bool m_initialised;
+		enum class e_output
+		{
+			VARIANT, //tree of Variants, see JSON::get_parsed_json
+			COMPACT, //tree of 16 byte CompactValues, see JSON::get_compact_json
+			LAZY //nothing is parsed up front, values are read on access through JSON::get_lazy_json
+		};
+
+		enum class e_number : uint8_t
+		{
+			INT64,
+			UINT64, //positive integers above INT64_MAX
+			DOUBLE //fractions, exponents and integers outside the 64 bit range
+		};
 
-		static void init_conversions();
+		enum class e_parse_mode
+		{
+			TOKENISED, //StructuralIndex, then TokenList, then Parser
+			SINGLE_PASS, //SinglePassParser, builds the tree directly from the source
+			PARALLEL //ParallelParser, the elements of a large root array are parsed across threads
+		};
 
+		//Conversions read constant tables, so they are safe to call from any number of threads
 		static std::string e_char_to_string(e_char);
 		static e_char string_to_e_char(std::string&);
 		static bool e_char_exists(std::string&);
 
 		static std::string e_token_to_string(e_token);
 
-	private:
-
-		static std::unordered_map<e_char, std::string> m_e_character_to_string;
-		static std::unordered_map<std::string, e_char> m_string_to_character_e;
+		static e_char char_to_e_char(char c); //constant time lookup through c_CHAR_CLASS_TABLE
+	};
 
-		static std::unordered_map<e_token, std::string> m_e_token_to_string;
+	//One entry per byte value so the tokeniser can classify a character with a single array index
+	//rather than building a string and searching the conversion maps.
+	struct CharClassTable
+	{
+		Enums::e_char m_classes[256];
 	};
+
+	constexpr CharClassTable make_char_class_table()
+	{
+		using e_char = Enums::e_char;
+		CharClassTable table {};
+		for(int c = 0; c < 256; c++)
+			table.m_classes[c] = e_char::INVALID;
+		for(int c = 'a'; c <= 'z'; c++)
+			table.m_classes[c] = e_char::LETTER;
+		for(int c = 'A'; c <= 'Z'; c++)
+			table.m_classes[c] = e_char::LETTER;
+		for(int c = '0'; c <= '9'; c++)
+			table.m_classes[c] = e_char::NUMBER;
+		table.m_classes['-'] = e_char::NUMBER;
+		table.m_classes['{'] = e_char::BRACE_OPEN;
+		table.m_classes['}'] = e_char::BRACE_CLOSE;
+		table.m_classes[':'] = e_char::COLON;
+		table.m_classes[','] = e_char::COMMA;
+		table.m_classes['"'] = e_char::QUOTE;
+		table.m_classes['['] = e_char::BRACKET_OPEN;
+		table.m_classes[']'] = e_char::BRACKET_CLOSE;
+		table.m_classes['.'] = e_char::PERIOD;
+		table.m_classes['\n'] = e_char::NEWLINE;
+		table.m_classes[' '] = e_char::WHITESPACE;
+		table.m_classes['\t'] = e_char::WHITESPACE;
+		table.m_classes['\r'] = e_char::WHITESPACE;
+		return table;
+	}
+
+	constexpr CharClassTable c_CHAR_CLASS_TABLE = make_char_class_table();
+
+	inline Enums::e_char Enums::char_to_e_char(char c)
+	{
+		return c_CHAR_CLASS_TABLE.m_classes[static_cast<unsigned char>(c)];
+	}
 }
 
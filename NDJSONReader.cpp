@@ -0,0 +1,138 @@
+/*
+ * NDJSONReader.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "NDJSONReader.hpp"
+#include "SinglePassParser.hpp"
+#include "Tokeniser.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace MJSON;
+
+constexpr std::size_t NDJSONReader::c_MIN_BATCH_BYTES;
+constexpr std::size_t NDJSONReader::c_BATCHES_PER_THREAD;
+
+std::vector<std::shared_ptr<ContainerVariant>> NDJSONReader::load_src(std::string path)
+{
+	std::ifstream f(path);
+	std::ostringstream ss;
+	if(f)
+	{
+		ss << f.rdbuf();
+	}
+	return load_src_from_string(ss.str());
+}
+
+std::vector<std::shared_ptr<ContainerVariant>> NDJSONReader::load_src_from_string(const std::string& ndjson_src)
+{
+	std::vector<std::shared_ptr<ContainerVariant>> results;
+	std::vector<StringRef> records = split_records(ndjson_src.data(), ndjson_src.size());
+	results.resize(records.size());
+
+	_parse_records(records, [&results](std::size_t record_idx, std::shared_ptr<ContainerVariant> record)
+	{
+		results[record_idx] = std::move(record); //each slot is written by exactly one thread
+	});
+	return results;
+}
+
+void NDJSONReader::for_each_record(const std::string& ndjson_src, const RecordCallback_t& callback)
+{
+	_parse_records(split_records(ndjson_src.data(), ndjson_src.size()), callback);
+}
+
+void NDJSONReader::_parse_records(const std::vector<StringRef>& records, const RecordCallback_t& callback)
+{
+	std::vector<Batch> batches = _make_batches(records);
+
+	//One arena per batch keeps allocation thread local, every record of the batch shares it and its key pool
+	m_thread_pool.run(batches.size(), [&](std::size_t batch_idx)
+	{
+		const Batch& batch = batches[batch_idx];
+		std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+		KeyPool* key_pool = arena->create<KeyPool>(arena.get());
+		SinglePassParser parser;
+		for(std::size_t record_idx = batch.m_first_record; record_idx < batch.m_end_record; record_idx++)
+		{
+			const StringRef& record = records[record_idx];
+			ContainerVariant* root = parser.parse_into(record.begin(), record.end(), *arena, key_pool);
+			callback(record_idx, std::shared_ptr<ContainerVariant>(arena, root));
+		}
+	});
+}
+
+std::vector<StringRef> NDJSONReader::split_records(const char* ndjson_src, std::size_t length)
+{
+	//A raw newline can't appear inside a JSON string, so every newline is a record boundary
+	std::vector<StringRef> records;
+	const char* cursor = ndjson_src;
+	const char* end = ndjson_src + length;
+	while(cursor < end)
+	{
+		const char* line_end = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+		if(line_end == nullptr)
+			line_end = end;
+		if(Tokeniser::skip_whitespace(cursor, line_end) != line_end)
+			records.push_back(StringRef(cursor, line_end));
+		cursor = line_end + 1;
+	}
+	return records;
+}
+
+std::vector<NDJSONReader::Batch> NDJSONReader::_make_batches(const std::vector<StringRef>& records)
+{
+	std::size_t total_bytes = 0;
+	for(const StringRef& record : records)
+	{
+		total_bytes += record.size();
+	}
+	std::size_t batch_bytes = std::max(c_MIN_BATCH_BYTES, total_bytes / (m_thread_pool.get_thread_count() * c_BATCHES_PER_THREAD));
+
+	std::vector<Batch> batches;
+	Batch batch {0, 0};
+	std::size_t bytes = 0;
+	for(std::size_t idx = 0; idx < records.size(); idx++)
+	{
+		bytes += records[idx].size();
+		if(bytes >= batch_bytes)
+		{
+			batch.m_end_record = idx + 1;
+			batches.push_back(batch);
+			batch.m_first_record = idx + 1;
+			bytes = 0;
+		}
+	}
+	if(batch.m_first_record < records.size())
+	{
+		batch.m_end_record = records.size();
+		batches.push_back(batch);
+	}
+	return batches;
+}
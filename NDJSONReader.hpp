@@ -0,0 +1,76 @@
+/*
+ * NDJSONReader.hpp
+ * Reads newline delimited JSON (JSON Lines), where every line is a separate document.  Records are
+ * parsed in place from the source and in parallel, in batches spread across a ThreadPool.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "StringRef.hpp"
+#include "ThreadPool.hpp"
+#include "Variant.hpp"
+
+namespace MJSON
+{
+	class NDJSONReader
+	{
+	public:
+		using RecordCallback_t = std::function<void(std::size_t record_idx, std::shared_ptr<ContainerVariant> record)>;
+
+		explicit NDJSONReader(std::size_t num_threads = 0): m_thread_pool(num_threads) {} //0 uses one thread per hardware thread
+
+		//Every record, in the order they appear in the source
+		std::vector<std::shared_ptr<ContainerVariant>> load_src(std::string path);
+		std::vector<std::shared_ptr<ContainerVariant>> load_src_from_string(const std::string& ndjson_src);
+
+		//Calls callback once per record from the worker threads.  Records within a batch arrive in order,
+		//but batches are processed concurrently, so use record_idx if the order matters.
+		void for_each_record(const std::string& ndjson_src, const RecordCallback_t& callback);
+
+		std::size_t get_thread_count() const {return m_thread_pool.get_thread_count();}
+
+		static std::vector<StringRef> split_records(const char* ndjson_src, std::size_t length); //blank lines are skipped
+
+	private:
+		struct Batch
+		{
+			std::size_t m_first_record;
+			std::size_t m_end_record;
+		};
+
+		void _parse_records(const std::vector<StringRef>& records, const RecordCallback_t& callback);
+		std::vector<Batch> _make_batches(const std::vector<StringRef>& records);
+
+		static constexpr std::size_t c_MIN_BATCH_BYTES = 64 * 1024;
+		static constexpr std::size_t c_BATCHES_PER_THREAD = 4; //extra batches even out threads that get slower records
+
+		ThreadPool m_thread_pool;
+	};
+}
@@ -0,0 +1,131 @@
+/*
+ * NumberParser.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "NumberParser.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <locale.h>
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+
+using namespace MJSON;
+
+namespace
+{
+	//Every power of ten up to 10^22 is exactly representable as a double
+	const double c_EXACT_POWERS_OF_TEN[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+	const uint64_t c_MAX_EXACT_MANTISSA = uint64_t(1) << 53;
+
+	inline bool is_digit(char c)
+	{
+		return c >= '0' && c <= '9';
+	}
+}
+
+double NumberParser::_parse_double(const char* cursor, const char* end)
+{
+	const char* start = cursor;
+	bool negative = *cursor == '-';
+	if(negative)
+		cursor++;
+
+	//The mantissa gathers every digit, the decimal exponent records where the point was
+	uint64_t mantissa = 0;
+	int num_digits = 0;
+	int exponent = 0;
+	for(; cursor < end && is_digit(*cursor); cursor++, num_digits++)
+		mantissa = mantissa * 10 + (uint64_t)(*cursor - '0');
+
+	if(cursor < end && *cursor == '.')
+	{
+		cursor++;
+		const char* fraction = cursor;
+		while(end - cursor >= 8 && num_digits + 8 <= 19 && is_eight_digits(cursor))
+		{
+			mantissa = mantissa * 100000000 + parse_eight_digits(cursor);
+			cursor += 8;
+			num_digits += 8;
+		}
+		for(; cursor < end && is_digit(*cursor); cursor++, num_digits++)
+			mantissa = mantissa * 10 + (uint64_t)(*cursor - '0');
+		exponent = -(int)(cursor - fraction);
+	}
+
+	if(cursor < end && (*cursor == 'e' || *cursor == 'E'))
+	{
+		cursor++;
+		bool negative_exponent = *cursor == '-';
+		if(*cursor == '-' || *cursor == '+')
+			cursor++;
+		int explicit_exponent = 0;
+		for(; cursor < end && is_digit(*cursor); cursor++)
+		{
+			if(explicit_exponent < 100000) //far beyond any double, stops overflow
+				explicit_exponent = explicit_exponent * 10 + (*cursor - '0');
+		}
+		exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+	}
+
+	//Clinger's fast path, both operands are exact so the one rounding gives the correctly rounded result
+	if(num_digits <= 19 && mantissa <= c_MAX_EXACT_MANTISSA && exponent >= -22 && exponent <= 22)
+	{
+		double value = (double)mantissa;
+		value = exponent < 0 ? value / c_EXACT_POWERS_OF_TEN[-exponent] : value * c_EXACT_POWERS_OF_TEN[exponent];
+		return negative ? -value : value;
+	}
+	return _parse_double_slow(start, end);
+}
+
+//Number text in the source may not be followed by a terminator, so is copied before calling strtod
+double NumberParser::_parse_double_slow(const char* cursor, const char* end)
+{
+	std::size_t length = end - cursor;
+	char buffer[64];
+	if(length < sizeof(buffer))
+	{
+		std::memcpy(buffer, cursor, length);
+		buffer[length] = '\0';
+		return strtod_c_locale(buffer);
+	}
+	std::string copy(cursor, length);
+	return strtod_c_locale(copy.c_str());
+}
+
+double NumberParser::strtod_c_locale(const char* str)
+{
+#if defined(_MSC_VER)
+	static const _locale_t c_locale = _create_locale(LC_ALL, "C");
+	return _strtod_l(str, nullptr, c_locale);
+#else
+	static const locale_t c_locale = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+	return strtod_l(str, nullptr, c_locale);
+#endif
+}
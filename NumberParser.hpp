@@ -0,0 +1,191 @@
+/*
+ * NumberParser.hpp
+ * Converts JSON number text to int64_t, uint64_t or double without allocating, throwing or
+ * consulting the locale.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+#include "MJSONEnums.hpp"
+#include "StringRef.hpp"
+
+namespace MJSON
+{
+	struct ParsedNumber
+	{
+		Enums::e_number m_type = Enums::e_number::INT64;
+		union
+		{
+			int64_t m_int64 = 0;
+			uint64_t m_uint64;
+			double m_double;
+		};
+
+		double to_double() const;
+		int64_t to_int64() const;
+	};
+
+	//Integers are read eight digits at a time with SWAR arithmetic.  Doubles whose digits fit in 53 bits and
+	//whose exponent is within +/-22 are exact with a single multiply or divide (Clinger's fast path),
+	//anything else falls back to strtod in the "C" locale.  Number text must already have been validated by the tokeniser.
+	class NumberParser
+	{
+	public:
+		static ParsedNumber parse(StringRef number);
+
+		//True for fractions, exponents and integers that do not fit in 64 bits, deciding float_t or int_t
+		static bool is_float(StringRef number);
+
+		//strtod that always uses '.' as the decimal point, whatever LC_NUMERIC the process has set
+		static double strtod_c_locale(const char* str);
+
+		static bool is_eight_digits(const char* chars);
+		static uint32_t parse_eight_digits(const char* chars); //chars must pass is_eight_digits
+
+	private:
+		static bool _parse_integer(const char* cursor, const char* end, ParsedNumber& number); //false if out of range
+		static double _parse_double(const char* cursor, const char* end);
+		static double _parse_double_slow(const char* cursor, const char* end);
+	};
+
+	inline double ParsedNumber::to_double() const
+	{
+		switch(m_type)
+		{
+		case Enums::e_number::INT64: return (double)m_int64;
+		case Enums::e_number::UINT64: return (double)m_uint64;
+		default: return m_double;
+		}
+	}
+
+	inline int64_t ParsedNumber::to_int64() const
+	{
+		switch(m_type)
+		{
+		case Enums::e_number::INT64: return m_int64;
+		case Enums::e_number::UINT64: return INT64_MAX;
+		default:
+			if(m_double >= 9223372036854775807.0)
+				return INT64_MAX;
+			if(m_double <= -9223372036854775808.0)
+				return INT64_MIN;
+			return (int64_t)m_double;
+		}
+	}
+
+	inline ParsedNumber NumberParser::parse(StringRef number)
+	{
+		ParsedNumber parsed;
+		if(is_float(number) || !_parse_integer(number.begin(), number.end(), parsed))
+		{
+			parsed.m_type = Enums::e_number::DOUBLE;
+			parsed.m_double = _parse_double(number.begin(), number.end());
+		}
+		return parsed;
+	}
+
+	inline bool NumberParser::is_float(StringRef number)
+	{
+		for(char c : number)
+		{
+			if(c == '.' || c == 'e' || c == 'E')
+				return true;
+		}
+		if(number.size() < 19) //too few digits to overflow
+			return false;
+		ParsedNumber parsed;
+		return !_parse_integer(number.begin(), number.end(), parsed);
+	}
+
+	inline bool NumberParser::is_eight_digits(const char* chars)
+	{
+		uint64_t block;
+		std::memcpy(&block, chars, sizeof(block));
+		//every byte must be 0x30-0x39, adding 6 must not carry any byte past 0x3F
+		return ((block & 0xF0F0F0F0F0F0F0F0ULL) | (((block + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+	}
+
+	inline uint32_t NumberParser::parse_eight_digits(const char* chars)
+	{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		uint32_t value = 0;
+		for(int idx = 0; idx < 8; idx++)
+			value = value * 10 + (chars[idx] - '0');
+		return value;
+#else
+		//combines neighbouring digits into pairs, then pairs into fours, then fours into the final value
+		uint64_t block;
+		std::memcpy(&block, chars, sizeof(block));
+		block -= 0x3030303030303030ULL;
+		block = (block * 10) + (block >> 8);
+		return (uint32_t)((((block & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+				(((block >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32);
+#endif
+	}
+
+	inline bool NumberParser::_parse_integer(const char* cursor, const char* end, ParsedNumber& number)
+	{
+		bool negative = cursor < end && *cursor == '-';
+		if(negative)
+			cursor++;
+
+		const char* digits = cursor;
+		uint64_t value = 0;
+		while(end - cursor >= 8 && is_eight_digits(cursor))
+		{
+			value = value * 100000000 + parse_eight_digits(cursor);
+			cursor += 8;
+		}
+		for(; cursor < end; cursor++)
+			value = value * 10 + (uint64_t)(*cursor - '0');
+
+		//UINT64_MAX has 20 digits.  A 20 digit number starting with 1 wraps at most once, so is out of range if it did.
+		std::size_t num_digits = cursor - digits;
+		if(num_digits > 20 || (num_digits == 20 && (digits[0] != '1' || value < 10000000000000000000ULL)))
+			return false;
+
+		if(negative)
+		{
+			if(value > (uint64_t)INT64_MAX + 1)
+				return false;
+			number.m_type = Enums::e_number::INT64;
+			number.m_int64 = (int64_t)(0 - value);
+		}
+		else if(value > (uint64_t)INT64_MAX)
+		{
+			number.m_type = Enums::e_number::UINT64;
+			number.m_uint64 = value;
+		}
+		else
+		{
+			number.m_type = Enums::e_number::INT64;
+			number.m_int64 = (int64_t)value;
+		}
+		return true;
+	}
+}
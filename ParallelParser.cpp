@@ -0,0 +1,110 @@
+/*
+ * ParallelParser.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "ParallelParser.hpp"
+#include "SinglePassParser.hpp"
+#include "Tokeniser.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace MJSON;
+
+constexpr std::size_t ParallelParser::c_MIN_BATCH_BYTES;
+constexpr std::size_t ParallelParser::c_BATCHES_PER_THREAD;
+
+std::shared_ptr<ContainerVariant> ParallelParser::parse(const char* json_src, std::size_t length)
+{
+	const char* end = json_src + length;
+	const char* array_start = Tokeniser::skip_whitespace(json_src, end);
+	if(array_start == end || *array_start != '[' || length < c_MIN_BATCH_BYTES * 2 || m_thread_pool.get_thread_count() == 1)
+	{
+		SinglePassParser parser;
+		return parser.parse(json_src, length);
+	}
+
+	std::vector<StringRef> batches = _split_elements(array_start, end);
+	std::vector<std::unique_ptr<Arena>> arenas(batches.size());
+	std::vector<VectorVariant*> results(batches.size());
+
+	m_thread_pool.run(batches.size(), [&](std::size_t batch_idx)
+	{
+		arenas[batch_idx].reset(new Arena());
+		Arena& arena = *arenas[batch_idx];
+		SinglePassParser parser;
+		results[batch_idx] = parser.parse_elements_into(batches[batch_idx].begin(), batches[batch_idx].end(), arena, arena.create<KeyPool>(&arena));
+	});
+
+	//The batches' element pointers are spliced into the root in order, the batch arenas are kept by the root's
+	std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+	VectorVariant* root = arena->create<VectorVariant>(arena.get(), arena->create<KeyPool>(arena.get()));
+	std::size_t num_elements = 0;
+	for(VectorVariant* result : results)
+		num_elements += result->m_container.size();
+	root->m_container.reserve(num_elements);
+
+	for(std::size_t batch_idx = 0; batch_idx < batches.size(); batch_idx++)
+	{
+		const VariantVec_t& elements = results[batch_idx]->m_container;
+		root->m_container.insert(root->m_container.end(), elements.begin(), elements.end());
+		arena->adopt(std::move(arenas[batch_idx]));
+	}
+	return std::shared_ptr<ContainerVariant>(arena, root);
+}
+
+std::vector<StringRef> ParallelParser::_split_elements(const char* array_start, const char* end)
+{
+	const std::size_t batch_bytes = std::max(c_MIN_BATCH_BYTES, (std::size_t)(end - array_start) / (m_thread_pool.get_thread_count() * c_BATCHES_PER_THREAD));
+
+	std::vector<StringRef> batches;
+	const char* cursor = Tokeniser::skip_whitespace(array_start + 1, end);
+	assert(cursor < end && "Unterminated array found\n");
+	if(cursor == end || *cursor == ']')
+		return batches;
+
+	const char* batch_start = cursor;
+	while(true)
+	{
+		const char* value_end = Tokeniser::find_value_end(cursor, end);
+		cursor = Tokeniser::skip_whitespace(value_end, end);
+		assert(cursor < end && (*cursor == ',' || *cursor == ']') && "Expected a comma or the end of the array\n");
+		if(cursor == end)
+			break;
+
+		bool is_last = *cursor == ']';
+		cursor = Tokeniser::skip_whitespace(cursor + 1, end);
+		if(is_last || (std::size_t)(value_end - batch_start) >= batch_bytes)
+		{
+			batches.push_back(StringRef(batch_start, value_end));
+			batch_start = cursor;
+		}
+		if(is_last)
+			break;
+	}
+	assert(cursor == end && "Only whitespace may follow the root array\n");
+	return batches;
+}
@@ -0,0 +1,65 @@
+/*
+ * ParallelParser.hpp
+ * Parses a document whose root is a large array by splitting its elements into batches, parsing the
+ * batches on a ThreadPool and joining the results into one tree.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "StringRef.hpp"
+#include "ThreadPool.hpp"
+#include "Variant.hpp"
+
+namespace MJSON
+{
+	//Element boundaries are found by matching brackets, which is much faster than parsing, then each batch is
+	//parsed by a SinglePassParser into its own arena and key pool.  The root's arena adopts the batch arenas.
+	//Documents that aren't a root array, or are too small to be worth splitting, are parsed on the calling thread.
+	class ParallelParser
+	{
+	public:
+		explicit ParallelParser(std::size_t num_threads = 0): //0 uses one thread per hardware thread
+			m_own_thread_pool(new ThreadPool(num_threads)), m_thread_pool(*m_own_thread_pool)
+		{}
+
+		explicit ParallelParser(ThreadPool& thread_pool): m_thread_pool(thread_pool) {}
+
+		std::shared_ptr<ContainerVariant> parse(const char* json_src, std::size_t length);
+
+		std::size_t get_thread_count() const {return m_thread_pool.get_thread_count();}
+
+	private:
+		std::vector<StringRef> _split_elements(const char* array_start, const char* end); //runs of whole elements
+
+		static constexpr std::size_t c_MIN_BATCH_BYTES = 64 * 1024;
+		static constexpr std::size_t c_BATCHES_PER_THREAD = 4; //extra batches even out threads that get slower elements
+
+		std::unique_ptr<ThreadPool> m_own_thread_pool;
+		ThreadPool& m_thread_pool;
+	};
+}
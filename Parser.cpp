@@ -27,6 +27,7 @@
 
 #include "Parser.hpp"
 #include "Variant.hpp"
+#include "NumberParser.hpp"
 
 #include <iostream>
 #include <cassert>
@@ -35,31 +36,25 @@ using namespace MJSON;
 
 using e_token = Enums::e_token;
 
-bool Parser::m_initialised = false;
-std::unordered_map<Enums::e_token, Variant::type> Parser::m_e_token_to_variant_type;
-
-void Parser::init_conversions()
+std::shared_ptr<ContainerVariant> Parser::parse_tokens(TokenList& token_list)
 {
-	if(m_initialised)
-		return;
-	m_initialised = true;
-
-	//enum class type {null_t, int_t, float_t,bool_t, string_t, container_t, vector_t, map_t, end};
-	m_e_token_to_variant_type[e_token::BOOL] = Variant::type::bool_t;
-	m_e_token_to_variant_type[e_token::STRING] = Variant::type::string_t;
-	m_e_token_to_variant_type[e_token::ARRAY_START] = Variant::type::vector_t;
-	m_e_token_to_variant_type[e_token::OBJECT_START] = Variant::type::map_t;
+	return parse_tokens(token_list, std::make_shared<Arena>());
 }
 
-std::shared_ptr<ContainerVariant> Parser::parse_tokens(TokenList& token_list)
+std::shared_ptr<ContainerVariant> Parser::parse_tokens(TokenList& token_list, std::shared_ptr<Arena> arena)
 {
-	std::stack<ContainerVariant*> stack;
+	//The arena owns the whole tree, released with the last reference to the root
+	KeyPool* key_pool = arena->create<KeyPool>(arena.get());
+	Stack_t& stack = m_stack;
+	while(!stack.empty())
+		stack.pop();
 	ContainerVariant* root_container = nullptr;
 	m_last_token_type = e_token::NOTHING;
+	m_token_list = &token_list;
 
 	for(int current_idx = 0; current_idx < token_list.size(); current_idx++)
 	{
-		Token* current_token = token_list[current_idx];
+		const Token* current_token = &token_list[current_idx];
 
 		//std::cout << "Parser::parse_tokens: " << current_token->to_string() << "\n";
 		switch(current_token->m_type)
@@ -72,7 +67,7 @@ std::shared_ptr<ContainerVariant> Parser::parse_tokens(TokenList& token_list)
 				if(m_last_token_type == e_token::NOTHING)
 				{
 					assert(root_container == nullptr && "Root container already set, something's gone wrong\n");
-					stack.push(new MapVariant);
+					stack.push(arena->create<MapVariant>(arena.get(), key_pool));
 					root_container = stack.top();
 					m_last_token_type = current_token->m_type;
 				}
@@ -93,7 +88,7 @@ std::shared_ptr<ContainerVariant> Parser::parse_tokens(TokenList& token_list)
 					if(m_last_token_type == e_token::NOTHING)
 					{
 						assert(root_container == nullptr && "Root container already set, something's gone wrong\n");
-						stack.push(new VectorVariant);
+						stack.push(arena->create<VectorVariant>(arena.get(), key_pool));
 						root_container = stack.top();
 						m_last_token_type = current_token->m_type;
 					}
@@ -114,10 +109,10 @@ std::shared_ptr<ContainerVariant> Parser::parse_tokens(TokenList& token_list)
 				assert(m_last_token_type != e_token::KEY &&
 						"Parser::parse_tokens: Invalid token sequence, object key can't follow another key, object end or array end\n");
 
-				std::string& key_string = current_token->m_value;
+				StringRef key_string = token_list.get_value(*current_token);
 
 				TokenExceptionList_t token_exceptions = { e_token::KEY , e_token::OBJECT_END, e_token::ARRAY_END };
-				Token* next_token = _get_next_token(current_idx, token_list, token_exceptions, 3);
+				const Token* next_token = _get_next_token(current_idx, token_list, token_exceptions, 3);
 				//std::cout << "Parser::parse_tokens:Key: " << current_token->to_string() << " value: " << next_token->to_string() << "\n";
 
 				if(next_token->m_type == e_token::ARRAY_START)
@@ -160,18 +155,20 @@ std::shared_ptr<ContainerVariant> Parser::parse_tokens(TokenList& token_list)
 		}
 	}
 	assert(stack.size() == 0 && "Stack should be empty, a container must not have ended (OBJECT_END or ARRAY_END)\n");
-	return std::shared_ptr<ContainerVariant>(root_container);
+	return std::shared_ptr<ContainerVariant>(arena, root_container);
 }
 
-void Parser::_add_key_value_pair_to_container(ContainerVariant* container, std::string key, Token* value)
+void Parser::_add_key_value_pair_to_container(ContainerVariant* container, StringRef key, const Token* value)
 {
-	Variant::type var_t = Variant::type::null_t;
-	var_t = _e_token_to_variant_type(value->m_type, value->m_value);
-	container->add_variant(var_t, value->m_value, key);
+	StringRef value_str = m_token_list->get_value(*value);
+	if(value->m_type == e_token::NUMBER)
+		container->add_number(NumberParser::parse(value_str), key, true); //parsed once, its type follows from the result
+	else
+		container->add_variant(_e_token_to_variant_type(value->m_type), value_str, key, true);
 	m_last_token_type = value->m_type;
 }
 
-void Parser::_array_start_nested(std::stack<ContainerVariant*>& stack,std::string map_key, Token* current_token)
+void Parser::_array_start_nested(Stack_t& stack, StringRef map_key, const Token* current_token)
 {
 	ContainerVariant* current_container = stack.top();
 	_add_key_value_pair_to_container(current_container, map_key, current_token);
@@ -181,7 +178,7 @@ void Parser::_array_start_nested(std::stack<ContainerVariant*>& stack,std::strin
 	m_last_token_type = current_token->m_type;
 }
 
-void Parser::_object_start_nested(std::stack<ContainerVariant*>& stack,std::string map_key, Token* current_token)
+void Parser::_object_start_nested(Stack_t& stack, StringRef map_key, const Token* current_token)
 {
 	ContainerVariant* current_container = stack.top();
 	_add_key_value_pair_to_container(current_container, map_key, current_token); //create and add new VariantMap
@@ -191,7 +188,7 @@ void Parser::_object_start_nested(std::stack<ContainerVariant*>& stack,std::stri
 	m_last_token_type = current_token->m_type;
 }
 
-void Parser::_array_end(std::stack<ContainerVariant*>& stack)
+void Parser::_array_end(Stack_t& stack)
 {
 	if(_is_token_invalid(m_last_token_type, {e_token::OBJECT_START, e_token::KEY}, 2))
 		assert(false && "Invalid token sequence.\n");
@@ -201,7 +198,7 @@ void Parser::_array_end(std::stack<ContainerVariant*>& stack)
 	m_last_token_type = e_token::ARRAY_END;
 }
 
-void Parser::_object_end(std::stack<ContainerVariant*>& stack)
+void Parser::_object_end(Stack_t& stack)
 {
 	if(_is_token_invalid(m_last_token_type, {e_token::OBJECT_START, e_token::KEY, e_token::ARRAY_START}, 3))
 						assert(false && "Invalid token sequence.\n");
@@ -210,17 +207,21 @@ void Parser::_object_end(std::stack<ContainerVariant*>& stack)
 	stack.pop();
 	m_last_token_type = e_token::OBJECT_END;
 }
-Variant::type Parser::_e_token_to_variant_type(e_token token, std::string value_str)
+Variant::type Parser::_e_token_to_variant_type(e_token token, StringRef value_str)
 {
-	Parser::init_conversions();
-	if(Parser::m_e_token_to_variant_type.find(token) != Parser::m_e_token_to_variant_type.end())
+	switch(token)
 	{
-		return Parser::m_e_token_to_variant_type[token];
+	case e_token::BOOL: return Variant::type::bool_t;
+	case e_token::STRING: return Variant::type::string_t;
+	case e_token::ARRAY_START: return Variant::type::vector_t;
+	case e_token::OBJECT_START: return Variant::type::map_t;
+	default: break;
 	}
-	else if(token == e_token::NUMBER)
+
+	if(token == e_token::NUMBER)
 	{
-		assert(value_str != "" && "To convert token enum to variant enum, requires the numbers value to deduce float or int\n");
-		if(value_str.find(".") != std::string::npos)
+		assert(!value_str.empty() && "To convert token enum to variant enum, requires the numbers value to deduce float or int\n");
+		if(NumberParser::is_float(value_str))
 			return Variant::type::float_t;
 		else
 			return Variant::type::int_t;
@@ -231,9 +232,9 @@ Variant::type Parser::_e_token_to_variant_type(e_token token, std::string value_
 	}
 }
 
-Token* Parser::_get_next_token(int current_idx, TokenList& token_list, TokenExceptionList_t token_exception_list, int exception_list_size)
+const Token* Parser::_get_next_token(int current_idx, TokenList& token_list, TokenExceptionList_t token_exception_list, int exception_list_size)
 {
-	Token* next_token = token_list[current_idx + 1];
+	const Token* next_token = &token_list[current_idx + 1];
 	bool error_type = false;
 
 	for(int idx = 0; idx < exception_list_size; idx ++)
@@ -32,6 +32,7 @@
 #include "Variant.hpp"
 #include <array>
 #include <stack>
+#include <vector>
 
 namespace MJSON
 {
@@ -42,30 +43,31 @@ namespace MJSON
 	public:
 
 		std::shared_ptr<ContainerVariant> parse_tokens(TokenList&);
+		std::shared_ptr<ContainerVariant> parse_tokens(TokenList&, std::shared_ptr<Arena> arena); //builds the tree in an empty arena
 
 	private:
+		using Stack_t = std::stack<ContainerVariant*, std::vector<ContainerVariant*>>; //keeps its capacity between documents
 
-		void _add_key_value_pair_to_container(ContainerVariant* container, std::string key, Token* value);
-		void _array_start_nested(std::stack<ContainerVariant*>& stack, std::string map_key, Token* current_token);
-		void _object_start_nested(std::stack<ContainerVariant*>& stack, std::string map_key, Token* current_token);
-		void _array_end(std::stack<ContainerVariant*>& stack);
-		void _object_end(std::stack<ContainerVariant*>& stack);
+		void _add_key_value_pair_to_container(ContainerVariant* container, StringRef key, const Token* value);
+		void _array_start_nested(Stack_t& stack, StringRef map_key, const Token* current_token);
+		void _object_start_nested(Stack_t& stack, StringRef map_key, const Token* current_token);
+		void _array_end(Stack_t& stack);
+		void _object_end(Stack_t& stack);
 
-		Variant::type _e_token_to_variant_type(Enums::e_token, std::string value_str = "");
+		Variant::type _e_token_to_variant_type(Enums::e_token, StringRef value_str = StringRef());
 
 		static constexpr int c_TOKEN_EXCEPTION_LIST_SIZE_MAX = 10;
 		using TokenExceptionList_t = std::array<Enums::e_token, c_TOKEN_EXCEPTION_LIST_SIZE_MAX>;
 		using TokenFilter_list_t = TokenExceptionList_t;
 
-		Token* _get_next_token(int current_idx, TokenList&, TokenExceptionList_t token_exception_list, int exception_list_size);
+		const Token* _get_next_token(int current_idx, TokenList&, TokenExceptionList_t token_exception_list, int exception_list_size);
 		bool _is_token_valid(Enums::e_token token_type, TokenFilter_list_t valid_tokens, int filter_list_size);
 		bool _is_token_invalid(Enums::e_token token_type, TokenFilter_list_t invalid_tokens, int filter_list_size);
 
 
 
 		Enums::e_token m_last_token_type = Enums::e_token::NOTHING;
-		static bool m_initialised;
-		static void init_conversions();
-		static std::unordered_map<Enums::e_token, Variant::type> m_e_token_to_variant_type;
+		TokenList* m_token_list = nullptr; //list being parsed, token values are read from its source
+		Stack_t m_stack;
 	};
 }
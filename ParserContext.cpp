@@ -0,0 +1,52 @@
+/*
+ * ParserContext.cpp
+ * Reusable buffers for parsing many documents in turn
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+#include "ParserContext.hpp"
+
+using namespace MJSON;
+
+std::shared_ptr<ContainerVariant> ParserContext::parse(const char* json_src, std::size_t length)
+{
+	return m_parser.parse_tokens(tokenise(json_src, length), _take_arena());
+}
+
+TokenList& ParserContext::tokenise(const char* json_src, std::size_t length)
+{
+	m_tokeniser.tokenise(json_src, length, m_token_list);
+	return m_token_list;
+}
+
+std::shared_ptr<Arena> ParserContext::_take_arena()
+{
+	//A use count of one means every tree built in the arena has been released.  Only this context can
+	//copy m_arena, so the count can't rise again behind our back.
+	if(m_arena != nullptr && m_arena.use_count() == 1)
+		m_arena->reset();
+	else
+		m_arena = std::make_shared<Arena>();
+	return m_arena;
+}
@@ -0,0 +1,67 @@
+/*
+ * ParserContext.hpp
+ * Reusable buffers for parsing many documents in turn
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <memory>
+
+#include "Arena.hpp"
+#include "Parser.hpp"
+#include "StringRef.hpp"
+#include "TokenList.hpp"
+#include "Tokeniser.hpp"
+#include "Variant.hpp"
+
+namespace MJSON
+{
+	//Keeps the buffers used to parse a document so a stream of documents, such as small messages, reuses them.
+	//The structural index, token list, parser stack and arena keep their capacity, so once they have grown to
+	//fit the largest document a parse makes no heap allocations.  The arena is only reset and reused once
+	//nothing refers to the previous tree, otherwise the next parse starts a new one.  A context is used by one
+	//thread at a time, give each thread its own.
+	class ParserContext
+	{
+	public:
+		std::shared_ptr<ContainerVariant> parse(const char* json_src, std::size_t length);
+		std::shared_ptr<ContainerVariant> parse(StringRef json_src) {return parse(json_src.data(), json_src.size());}
+
+		//Token list of a source, valid until the next call.  The source must outlive the list's use.
+		TokenList& tokenise(const char* json_src, std::size_t length);
+
+		void set_thread_pool(ThreadPool* thread_pool) {m_tokeniser.set_thread_pool(thread_pool);} //see Tokeniser
+
+		std::size_t get_arena_bytes_reserved() const {return m_arena != nullptr ? m_arena->get_bytes_reserved() : 0;}
+
+	private:
+		std::shared_ptr<Arena> _take_arena(); //the retained arena when no tree refers to it
+
+		Tokeniser m_tokeniser;
+		TokenList m_token_list;
+		Parser m_parser;
+		std::shared_ptr<Arena> m_arena;
+	};
+}
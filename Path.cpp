@@ -0,0 +1,200 @@
+/*
+ * Path.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "Path.hpp"
+
+#include <cassert>
+
+using namespace MJSON;
+
+constexpr int Path::c_NO_INDEX;
+
+Path Path::from_pointer(StringRef pointer)
+{
+	Path path;
+	if(pointer.empty())
+		return path;
+	assert(pointer[0] == '/' && "A JSON pointer must be empty or start with '/'\n");
+
+	std::string key;
+	for(std::size_t idx = 1; idx <= pointer.size(); idx++)
+	{
+		if(idx == pointer.size() || pointer[idx] == '/')
+		{
+			path._add_step(key, StringRef(key).hash());
+			key.clear();
+		}
+		else if(pointer[idx] == '~')
+		{
+			assert(idx + 1 < pointer.size() && (pointer[idx + 1] == '0' || pointer[idx + 1] == '1') && "Invalid escape in JSON pointer, expected ~0 or ~1\n");
+			key += pointer[++idx] == '0' ? '~' : '/';
+		}
+		else
+		{
+			key += pointer[idx];
+		}
+	}
+	return path;
+}
+
+Path Path::from_dotted(StringRef dotted)
+{
+	Path path;
+	const char* cursor = dotted.begin();
+	const char* end = dotted.end();
+	while(cursor < end)
+	{
+		if(*cursor == '[')
+		{
+			const char* close = cursor + 1;
+			while(close < end && *close != ']')
+				close++;
+			assert(close < end && "Unterminated [ in dotted path\n");
+			StringRef index(cursor + 1, close);
+			path._add_step(index, index.hash(), true);
+			assert(path.m_steps.back().m_index != c_NO_INDEX && "Expected an array index between [ and ]\n");
+			cursor = close + 1;
+		}
+		else
+		{
+			const char* key_end = cursor;
+			while(key_end < end && *key_end != '.' && *key_end != '[')
+				key_end++;
+			StringRef key(cursor, key_end);
+			path._add_step(key, key.hash());
+			cursor = key_end;
+		}
+
+		if(cursor < end && *cursor == '.')
+		{
+			cursor++;
+			assert(cursor < end && "Dotted path must not end with '.'\n");
+		}
+	}
+	return path;
+}
+
+Variant* Path::evaluate(Variant* root) const
+{
+	Variant* current = root;
+	for(const Step& step : m_steps)
+	{
+		if(current == nullptr)
+			return nullptr;
+		if(current->m_type == Variant::type::map_t)
+		{
+			current = step.m_index_only ? nullptr : static_cast<MapVariant*>(current)->find(_get_key(step), step.m_hash);
+		}
+		else if(current->m_type == Variant::type::vector_t)
+		{
+			current = static_cast<VectorVariant*>(current)->find(step.m_index);
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+	return current;
+}
+
+const CompactValue* Path::evaluate(const CompactValue& root) const
+{
+	const CompactValue* current = &root;
+	for(const Step& step : m_steps)
+	{
+		if(current == nullptr)
+			return nullptr;
+		const Variant::type type = current->get_type();
+		if(type == Variant::type::map_t)
+		{
+			current = step.m_index_only ? nullptr : current->find(_get_key(step));
+		}
+		else if(type == Variant::type::vector_t)
+		{
+			current = step.m_index != c_NO_INDEX && step.m_index < current->size() ? (*current)[step.m_index] : nullptr;
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+	return current;
+}
+
+std::string Path::to_pointer() const
+{
+	std::string pointer;
+	for(const Step& step : m_steps)
+	{
+		pointer += '/';
+		for(char c : _get_key(step))
+		{
+			if(c == '~')
+				pointer += "~0";
+			else if(c == '/')
+				pointer += "~1";
+			else
+				pointer += c;
+		}
+	}
+	return pointer;
+}
+
+Path& Path::append_index(int index)
+{
+	assert(index >= 0 && "Array index must not be negative\n");
+	std::string key = std::to_string(index);
+	_add_step(key, StringRef(key).hash(), true);
+	return *this;
+}
+
+void Path::_add_step(StringRef key, std::size_t hash, bool index_only)
+{
+	Step step;
+	step.m_key_offset = (uint32_t)m_keys.size();
+	step.m_key_size = (uint32_t)key.size();
+	step.m_hash = hash;
+	step.m_index = _parse_index(key);
+	step.m_index_only = index_only;
+	m_keys.append(key.data(), key.size());
+	m_steps.push_back(step);
+}
+
+//RFC 6901 array indices, "0" or digits without a leading zero.  "-", the element past the end, never matches.
+int Path::_parse_index(StringRef key)
+{
+	if(key.empty() || key.size() > 9 || (key[0] == '0' && key.size() > 1))
+		return c_NO_INDEX;
+	int index = 0;
+	for(char c : key)
+	{
+		if(c < '0' || c > '9')
+			return c_NO_INDEX;
+		index = index * 10 + (c - '0');
+	}
+	return index;
+}
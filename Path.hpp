@@ -0,0 +1,93 @@
+/*
+ * Path.hpp
+ * Compiled JSON Pointer (RFC 6901) and dotted paths.  A path is parsed once, with its keys hashed
+ * and its indices converted, so evaluating it against a document does no parsing or allocation.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CompactValue.hpp"
+#include "StringRef.hpp"
+#include "Variant.hpp"
+
+namespace MJSON
+{
+	//Each step matches an object member by key, or an array element by index.  A pointer or dotted step
+	//made only of digits can match either, "a.0" reads key "0" of an object or element 0 of an array.
+	class Path
+	{
+	public:
+		Path() = default; //empty, evaluates to the root
+
+		static Path from_pointer(StringRef pointer); //"/transform/m_position/0", "~0" and "~1" escape '~' and '/'
+		static Path from_dotted(StringRef dotted); //"transform.m_position[0]" or "transform.m_position.0"
+
+		//Builds a path a step at a time, a StaticKey's hash is reused rather than computed
+		Path& append_key(StringRef key) {_add_step(key, key.hash()); return *this;}
+		Path& append_key(const StaticKey& key) {_add_step(key.get_string(), key.hash()); return *this;}
+		Path& append_index(int index);
+
+		//nullptr if any step is missing, or steps into a value that isn't a container
+		Variant* evaluate(Variant* root) const;
+		const CompactValue* evaluate(const CompactValue& root) const;
+
+		template<typename T>
+		T* get(Variant* root) const //nullptr when missing or not a T
+		{
+			return variant_cast<T>(evaluate(root));
+		}
+
+		std::size_t size() const {return m_steps.size();}
+		bool empty() const {return m_steps.empty();}
+		StringRef get_key(std::size_t step) const {return _get_key(m_steps[step]);} //unescaped, an index step's digits
+		bool is_index(std::size_t step) const {return m_steps[step].m_index != c_NO_INDEX;} //can address an array element, as evaluate treats it
+
+		std::string to_pointer() const;
+
+	private:
+		static constexpr int c_NO_INDEX = -1;
+
+		struct Step
+		{
+			uint32_t m_key_offset; //into m_keys
+			uint32_t m_key_size;
+			std::size_t m_hash;
+			int m_index; //c_NO_INDEX if the step can't match an array element
+			bool m_index_only; //written as [n] in a dotted path
+		};
+
+		void _add_step(StringRef key, std::size_t hash, bool index_only = false); //key must already be unescaped
+		StringRef _get_key(const Step& step) const {return StringRef(m_keys.data() + step.m_key_offset, step.m_key_size);}
+		static int _parse_index(StringRef key);
+
+		std::string m_keys; //every step's key, back to back
+		std::vector<Step> m_steps;
+	};
+}
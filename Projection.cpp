@@ -0,0 +1,77 @@
+/*
+ * Projection.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "Projection.hpp"
+
+using namespace MJSON;
+
+constexpr int Projection::c_KEEP_ALL;
+constexpr int Projection::c_SKIP;
+
+Projection& Projection::add(const Path& path)
+{
+	if(m_nodes.empty())
+		_add_node(StringRef());
+
+	int node = 0;
+	for(std::size_t step = 0; step < path.size() && !m_nodes[node].m_is_leaf; step++)
+	{
+		if(path.is_index(step))
+			continue; //arrays don't consume a step, so every element is kept rather than the one indexed
+
+		StringRef key = path.get_key(step);
+		int child = m_nodes[node].m_first_child;
+		while(child != -1 && _get_key(m_nodes[child]) != key)
+			child = m_nodes[child].m_next_sibling;
+
+		if(child == -1)
+		{
+			child = _add_node(key);
+			m_nodes[child].m_next_sibling = m_nodes[node].m_first_child;
+			m_nodes[node].m_first_child = child;
+		}
+		node = child;
+	}
+
+	//A shorter path keeps everything a longer one would have
+	m_nodes[node].m_is_leaf = true;
+	m_nodes[node].m_first_child = -1;
+	return *this;
+}
+
+int Projection::_add_node(StringRef key)
+{
+	Node node;
+	node.m_key_offset = (uint32_t)m_keys.size();
+	node.m_key_size = (uint32_t)key.size();
+	node.m_first_child = -1;
+	node.m_next_sibling = -1;
+	node.m_is_leaf = false;
+	m_keys.append(key.data(), key.size());
+	m_nodes.push_back(node);
+	return (int)m_nodes.size() - 1;
+}
@@ -0,0 +1,86 @@
+/*
+ * Projection.hpp
+ * The set of members a parse should keep.  Values outside the projection are skipped in the source
+ * without any Variant being created for them.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Path.hpp"
+#include "StringRef.hpp"
+
+namespace MJSON
+{
+	//A trie of the keys along each added path.  A member at the end of a path is kept with everything
+	//beneath it.  Arrays don't consume a step, every element is filtered by the same node, so "/name"
+	//keeps the name of each record in a root array.  Scalar elements of an array on a path are dropped.
+	//For the same reason index steps are skipped, "tags[1].name", "tags.1.name" and "/tags/1/name" all keep
+	//the name of every element of tags.  A digit only key of an object is skipped too, keeping more than asked.
+	class Projection
+	{
+	public:
+		static constexpr int c_KEEP_ALL = -1; //node below the end of a path, everything is kept
+		static constexpr int c_SKIP = -2; //not part of any path
+
+		Projection& add(const Path& path);
+		Projection& add_pointer(StringRef pointer) {return add(Path::from_pointer(pointer));}
+		Projection& add_dotted(StringRef dotted) {return add(Path::from_dotted(dotted));}
+
+		bool empty() const {return m_nodes.empty();}
+
+		int get_root() const {return m_nodes.empty() || m_nodes[0].m_is_leaf ? c_KEEP_ALL : 0;}
+		int find_child(int node, StringRef key) const; //node must not be c_KEEP_ALL
+
+	private:
+		struct Node
+		{
+			uint32_t m_key_offset; //into m_keys
+			uint32_t m_key_size;
+			int m_first_child;
+			int m_next_sibling;
+			bool m_is_leaf;
+		};
+
+		int _add_node(StringRef key);
+		StringRef _get_key(const Node& node) const {return StringRef(m_keys.data() + node.m_key_offset, node.m_key_size);}
+
+		std::string m_keys;
+		std::vector<Node> m_nodes; //m_nodes[0] is the root
+	};
+
+	inline int Projection::find_child(int node, StringRef key) const
+	{
+		for(int child = m_nodes[node].m_first_child; child != -1; child = m_nodes[child].m_next_sibling)
+		{
+			if(_get_key(m_nodes[child]) == key)
+				return m_nodes[child].m_is_leaf ? c_KEEP_ALL : child;
+		}
+		return c_SKIP;
+	}
+}
@@ -0,0 +1,213 @@
+/*
+ * PushParser.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "PushParser.hpp"
+#include "Tokeniser.hpp"
+#include "NumberParser.hpp"
+
+#include <cassert>
+
+using namespace MJSON;
+
+using e_char = Enums::e_char;
+
+void PushParser::reset()
+{
+	m_arena = std::make_shared<Arena>();
+	m_builder.begin(*m_arena);
+	m_state = e_state::BETWEEN_TOKENS;
+	m_escape_pending = false;
+	m_partial.clear();
+}
+
+void PushParser::feed(const char* data, std::size_t length)
+{
+	const char* cursor = data;
+	const char* end = data + length;
+
+	while(cursor < end)
+	{
+		switch(m_state)
+		{
+		case e_state::IN_STRING:
+			{
+				const char* str_end = _scan_string(cursor, end);
+				if(str_end == end)
+				{
+					m_partial.append(cursor, end);
+					cursor = end;
+					break;
+				}
+				_complete_string(_take_partial(cursor, str_end));
+				m_state = e_state::BETWEEN_TOKENS;
+				cursor = str_end + 1;
+				break;
+			}
+		case e_state::IN_NUMBER:
+		case e_state::IN_LITERAL:
+			{
+				const char* lexeme_end = cursor;
+				if(m_state == e_state::IN_NUMBER)
+					lexeme_end = Tokeniser::find_number_end(cursor, end);
+				else
+					while(lexeme_end < end && Enums::char_to_e_char(*lexeme_end) == e_char::LETTER)
+						lexeme_end++;
+
+				if(lexeme_end == end) //may continue in the next chunk
+				{
+					m_partial.append(cursor, end);
+					cursor = end;
+					break;
+				}
+				_complete_scalar(_take_partial(cursor, lexeme_end));
+				m_state = e_state::BETWEEN_TOKENS;
+				cursor = lexeme_end;
+				break;
+			}
+		case e_state::BETWEEN_TOKENS:
+			{
+				cursor = Tokeniser::skip_whitespace(cursor, end);
+				if(cursor >= end)
+					break;
+
+				bool consumed = true; //numbers and literals keep their first character
+				switch(Enums::char_to_e_char(*cursor))
+				{
+				case e_char::BRACE_OPEN:
+					m_builder.open_container(Variant::type::map_t);
+					break;
+				case e_char::BRACKET_OPEN:
+					m_builder.open_container(Variant::type::vector_t);
+					break;
+				case e_char::BRACE_CLOSE:
+					m_builder.close_container(Variant::type::map_t);
+					break;
+				case e_char::BRACKET_CLOSE:
+					m_builder.close_container(Variant::type::vector_t);
+					break;
+				case e_char::COMMA:
+				case e_char::COLON:
+					break;
+				case e_char::QUOTE:
+					m_state = e_state::IN_STRING;
+					break;
+				case e_char::LETTER:
+					m_state = e_state::IN_LITERAL;
+					consumed = false;
+					break;
+				case e_char::NUMBER:
+					m_state = e_state::IN_NUMBER;
+					consumed = false;
+					break;
+				default:
+					assert(false && "Invalid character found\n");
+					break;
+				}
+				m_partial.clear();
+				if(consumed)
+					cursor++;
+				break;
+			}
+		}
+	}
+}
+
+std::shared_ptr<ContainerVariant> PushParser::finish()
+{
+	if(m_state == e_state::IN_NUMBER || m_state == e_state::IN_LITERAL) //the source ended on a number or literal
+	{
+		_complete_scalar(StringRef(m_partial));
+		m_state = e_state::BETWEEN_TOKENS;
+	}
+	assert(m_state == e_state::BETWEEN_TOKENS && "Unterminated string found\n");
+	assert(m_builder.is_complete() && "Stack should be empty, a container must not have ended (OBJECT_END or ARRAY_END)\n");
+
+	std::shared_ptr<ContainerVariant> root(m_arena, m_builder.get_root());
+	reset();
+	return root;
+}
+
+//Returns the closing quote, or end if the string continues into the next chunk
+const char* PushParser::_scan_string(const char* cursor, const char* end)
+{
+	if(m_escape_pending && cursor < end)
+	{
+		cursor++;
+		m_escape_pending = false;
+	}
+
+	while(cursor < end)
+	{
+		if(*cursor == '"')
+			return cursor;
+		if(*cursor == '\\')
+		{
+			if(cursor + 1 == end)
+			{
+				m_escape_pending = true;
+				return end;
+			}
+			cursor++;
+		}
+		cursor++;
+	}
+	return end;
+}
+
+void PushParser::_complete_string(StringRef str)
+{
+	if(m_builder.expects_key()) //a string in an object without a pending key must be the key
+	{
+		m_key.assign(str.data(), str.size());
+		m_builder.set_key(StringRef(m_key));
+	}
+	else
+	{
+		m_builder.add_value(Variant::type::string_t, str);
+	}
+}
+
+void PushParser::_complete_scalar(StringRef lexeme)
+{
+	if(Enums::char_to_e_char(lexeme[0]) == e_char::LETTER)
+	{
+		assert(Tokeniser::find_literal_end(lexeme.begin(), lexeme.end()) == lexeme.end() && "Character found at invalid position.  Not key, string, bool or null\n");
+		m_builder.add_value(lexeme[0] == 'n' ? Variant::type::null_t : Variant::type::bool_t, lexeme);
+	}
+	else
+	{
+		m_builder.add_number(NumberParser::parse(lexeme));
+	}
+}
+
+StringRef PushParser::_take_partial(const char* begin, const char* end)
+{
+	if(m_partial.empty())
+		return StringRef(begin, end); //whole lexeme is within this chunk, no copy needed
+	m_partial.append(begin, end);
+	return StringRef(m_partial);
+}
@@ -0,0 +1,70 @@
+/*
+ * PushParser.hpp
+ * Resumable parser for JSON arriving in pieces (pipes, sockets).  Each chunk is parsed as soon as it
+ * is fed, with strings, numbers and literals allowed to be split across chunk boundaries.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <memory>
+#include <string>
+
+#include "Arena.hpp"
+#include "StringRef.hpp"
+#include "Variant.hpp"
+#include "VariantBuilder.hpp"
+
+namespace MJSON
+{
+	class PushParser
+	{
+	public:
+		PushParser() {reset();}
+
+		void reset(); //discards any partial document and starts a new one
+
+		void feed(const char* data, std::size_t length); //data only needs to stay valid for the duration of the call
+		void feed(const std::string& chunk) {feed(chunk.data(), chunk.size());}
+
+		std::shared_ptr<ContainerVariant> finish(); //completes the document, the parser is then reset
+
+		bool is_complete() const {return m_state == e_state::BETWEEN_TOKENS && m_builder.is_complete();}
+
+	private:
+		enum class e_state { BETWEEN_TOKENS, IN_STRING, IN_NUMBER, IN_LITERAL };
+
+		const char* _scan_string(const char* cursor, const char* end);
+		void _complete_string(StringRef str);
+		void _complete_scalar(StringRef lexeme);
+		StringRef _take_partial(const char* begin, const char* end); //lexeme that may have started in an earlier chunk
+
+		std::shared_ptr<Arena> m_arena;
+		VariantBuilder m_builder;
+		e_state m_state = e_state::BETWEEN_TOKENS;
+		bool m_escape_pending = false; //chunk ended on a backslash within a string
+		std::string m_partial; //start of a lexeme split across chunks
+		std::string m_key; //copy of the pending key, the chunk it came from may already be gone
+	};
+}
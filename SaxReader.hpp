@@ -0,0 +1,168 @@
+/*
+ * SaxReader.hpp
+ * Event based reading for consumers that do not need a tree.  The reader scans the source once with
+ * the Tokeniser helpers and calls the handler for every value, allocating no Variants.  Memory use is
+ * bounded by the nesting depth of the document rather than its size.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MJSONEnums.hpp"
+#include "NumberParser.hpp"
+#include "StringRef.hpp"
+#include "Tokeniser.hpp"
+
+namespace MJSON
+{
+	//Handlers can derive from SaxHandler and hide only the events they need.  The reader is templated on the
+	//handler type, so calls are resolved statically and can be inlined.  Strings and keys reference the source.
+	struct SaxHandler
+	{
+		void on_object_start() {}
+		void on_object_end() {}
+		void on_array_start() {}
+		void on_array_end() {}
+		void on_key(StringRef) {}
+		void on_string(StringRef) {}
+		void on_int(int64_t) {}
+		void on_uint(uint64_t) {} //only for integers above INT64_MAX
+		void on_float(double) {}
+		void on_bool(bool) {}
+		void on_null() {}
+	};
+
+	class SaxReader
+	{
+	public:
+		template<typename Handler>
+		void parse(const char* json_src, std::size_t length, Handler& handler);
+
+		template<typename Handler>
+		void parse(const std::string& json_src, Handler& handler)
+		{
+			parse(json_src.data(), json_src.size(), handler);
+		}
+
+	private:
+		std::vector<bool> m_in_object; //one entry per open container, retained between parses
+	};
+
+	template<typename Handler>
+	void SaxReader::parse(const char* json_src, std::size_t length, Handler& handler)
+	{
+		using e_char = Enums::e_char;
+
+		m_in_object.clear();
+		bool expects_key = false;
+
+		const char* cursor = json_src;
+		const char* end = json_src + length;
+		while(true)
+		{
+			cursor = Tokeniser::skip_whitespace(cursor, end);
+			if(cursor >= end)
+				break;
+
+			switch(Enums::char_to_e_char(*cursor))
+			{
+			case e_char::BRACE_OPEN:
+				handler.on_object_start();
+				m_in_object.push_back(true);
+				expects_key = true;
+				cursor++;
+				break;
+			case e_char::BRACKET_OPEN:
+				handler.on_array_start();
+				m_in_object.push_back(false);
+				expects_key = false;
+				cursor++;
+				break;
+			case e_char::BRACE_CLOSE:
+			case e_char::BRACKET_CLOSE:
+				assert(!m_in_object.empty() && m_in_object.back() == (*cursor == '}') && "Container end does not match its start\n");
+				if(m_in_object.back())
+					handler.on_object_end();
+				else
+					handler.on_array_end();
+				m_in_object.pop_back();
+				expects_key = false;
+				cursor++;
+				break;
+			case e_char::COMMA:
+				expects_key = !m_in_object.empty() && m_in_object.back();
+				cursor++;
+				break;
+			case e_char::COLON:
+				cursor++;
+				break;
+			case e_char::QUOTE:
+				{
+					const char* str_end = Tokeniser::find_string_end(cursor + 1, end);
+					StringRef str(cursor + 1, str_end);
+					if(expects_key)
+						handler.on_key(str);
+					else
+						handler.on_string(str);
+					expects_key = false;
+					cursor = str_end + 1;
+					break;
+				}
+			case e_char::LETTER:
+				{
+					const char* literal_end = Tokeniser::find_literal_end(cursor, end);
+					if(*cursor == 'n')
+						handler.on_null();
+					else
+						handler.on_bool(*cursor == 't');
+					cursor = literal_end;
+					break;
+				}
+			case e_char::NUMBER:
+				{
+					const char* number_end = Tokeniser::find_number_end(cursor, end);
+					ParsedNumber number = NumberParser::parse(StringRef(cursor, number_end));
+					if(number.m_type == Enums::e_number::INT64)
+						handler.on_int(number.m_int64);
+					else if(number.m_type == Enums::e_number::UINT64)
+						handler.on_uint(number.m_uint64);
+					else
+						handler.on_float(number.m_double);
+					cursor = number_end;
+					break;
+				}
+			default:
+				assert(false && "Invalid character found\n");
+				cursor++;
+				break;
+			}
+		}
+		assert(m_in_object.empty() && "A container must not have ended (OBJECT_END or ARRAY_END)\n");
+	}
+}
@@ -0,0 +1,170 @@
+/*
+ * SinglePassParser.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "SinglePassParser.hpp"
+#include "Tokeniser.hpp"
+#include "NumberParser.hpp"
+
+#include <cassert>
+
+using namespace MJSON;
+
+using e_char = Enums::e_char;
+
+std::shared_ptr<ContainerVariant> SinglePassParser::parse(const char* json_src, std::size_t length)
+{
+	std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+	ContainerVariant* root = parse_into(json_src, json_src + length, *arena);
+	return std::shared_ptr<ContainerVariant>(arena, root);
+}
+
+ContainerVariant* SinglePassParser::parse_into(const char* begin, const char* end, Arena& arena, KeyPool* key_pool)
+{
+	m_builder.begin(arena, key_pool);
+	if(m_projection != nullptr && m_projection->get_root() != Projection::c_KEEP_ALL)
+	{
+		m_nodes.clear();
+		m_member_node = m_projection->get_root();
+		_parse<true>(begin, end);
+	}
+	else
+	{
+		_parse<false>(begin, end);
+	}
+	assert(m_builder.is_complete() && "Stack should be empty, a container must not have ended (OBJECT_END or ARRAY_END)\n");
+	return m_builder.get_root();
+}
+
+VectorVariant* SinglePassParser::parse_elements_into(const char* begin, const char* end, Arena& arena, KeyPool* key_pool)
+{
+	m_builder.begin(arena, key_pool);
+	m_builder.open_container(Variant::type::vector_t);
+	_parse<false>(begin, end);
+	m_builder.close_container(Variant::type::vector_t);
+	assert(m_builder.is_complete() && "A container must not have ended (OBJECT_END or ARRAY_END)\n");
+	return static_cast<VectorVariant*>(m_builder.get_root());
+}
+
+//Without a projection the checks below are compiled out, leaving the plain single pass loop
+template<bool Projected>
+void SinglePassParser::_parse(const char* begin, const char* end)
+{
+	const char* cursor = begin;
+	while(true)
+	{
+		cursor = Tokeniser::skip_whitespace(cursor, end);
+		if(cursor >= end)
+			break;
+
+		switch(Enums::char_to_e_char(*cursor))
+		{
+		case e_char::BRACE_OPEN:
+			if(Projected)
+				m_nodes.push_back(m_nodes.empty() ? m_member_node : _next_node());
+			m_builder.open_container(Variant::type::map_t);
+			cursor++;
+			break;
+		case e_char::BRACKET_OPEN:
+			if(Projected)
+				m_nodes.push_back(m_nodes.empty() ? m_member_node : _next_node());
+			m_builder.open_container(Variant::type::vector_t);
+			cursor++;
+			break;
+		case e_char::BRACE_CLOSE:
+			if(Projected)
+				m_nodes.pop_back();
+			m_builder.close_container(Variant::type::map_t);
+			cursor++;
+			break;
+		case e_char::BRACKET_CLOSE:
+			if(Projected)
+				m_nodes.pop_back();
+			m_builder.close_container(Variant::type::vector_t);
+			cursor++;
+			break;
+		case e_char::COMMA:
+		case e_char::COLON:
+			cursor++;
+			break;
+		case e_char::QUOTE:
+			{
+				const char* str_end = Tokeniser::find_string_end(cursor + 1, end);
+				StringRef str(cursor + 1, str_end);
+				cursor = str_end + 1;
+				if(m_builder.expects_key()) //a string in an object without a pending key must be the key
+				{
+					if(Projected && m_nodes.back() != Projection::c_KEEP_ALL)
+					{
+						m_member_node = m_projection->find_child(m_nodes.back(), str);
+						cursor = Tokeniser::skip_whitespace(cursor, end);
+						assert(cursor < end && *cursor == ':' && "Expected a colon after an object key\n");
+						cursor = Tokeniser::skip_whitespace(cursor + 1, end);
+						assert(cursor < end && "Expected a value after an object key\n");
+
+						//Skipped members never reach the builder, nor do scalars where a path continues beneath them
+						if(m_member_node == Projection::c_SKIP || (m_member_node != Projection::c_KEEP_ALL && *cursor != '{' && *cursor != '['))
+						{
+							cursor = m_skip_index != nullptr ? m_skip_index->find_value_end(m_indexed_src, cursor, end) : Tokeniser::find_value_end(cursor, end);
+							break;
+						}
+					}
+					else if(Projected)
+					{
+						m_member_node = Projection::c_KEEP_ALL;
+					}
+					m_builder.set_key(str);
+				}
+				else if(!Projected || _keeps_scalar())
+				{
+					m_builder.add_value(Variant::type::string_t, str);
+				}
+				break;
+			}
+		case e_char::LETTER:
+			{
+				const char* literal_end = Tokeniser::find_literal_end(cursor, end);
+				if(!Projected || _keeps_scalar())
+					m_builder.add_value(*cursor == 'n' ? Variant::type::null_t : Variant::type::bool_t, StringRef(cursor, literal_end));
+				cursor = literal_end;
+				break;
+			}
+		case e_char::NUMBER:
+			{
+				const char* number_end = Tokeniser::find_number_end(cursor, end);
+				StringRef number(cursor, number_end);
+				if(!Projected || _keeps_scalar())
+					m_builder.add_number(NumberParser::parse(number));
+				cursor = number_end;
+				break;
+			}
+		default:
+			assert(false && "Invalid character found\n");
+			cursor++;
+			break;
+		}
+	}
+}
@@ -0,0 +1,82 @@
+/*
+ * SinglePassParser.hpp
+ * Builds the Variant tree straight from the JSON source in one pass, without a StructuralIndex or
+ * TokenList.  Select it with JSON::set_parse_mode(Enums::e_parse_mode::SINGLE_PASS).
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "Arena.hpp"
+#include "Projection.hpp"
+#include "SkipIndex.hpp"
+#include "StringRef.hpp"
+#include "Variant.hpp"
+#include "VariantBuilder.hpp"
+
+namespace MJSON
+{
+	class SinglePassParser
+	{
+	public:
+		std::shared_ptr<ContainerVariant> parse(const char* json_src, std::size_t length);
+
+		//Parses into an existing arena, returning the root container allocated from it.  Documents parsed into
+		//the same arena can share a key pool allocated from it.
+		ContainerVariant* parse_into(const char* begin, const char* end, Arena& arena, KeyPool* key_pool = nullptr);
+
+		//Parses comma separated values, such as a run of an array's elements, into a new VectorVariant
+		VectorVariant* parse_elements_into(const char* begin, const char* end, Arena& arena, KeyPool* key_pool = nullptr);
+
+		//Members outside the projection are skipped rather than parsed, nullptr parses everything.  The
+		//projection must outlive any parse it is used for.
+		void set_projection(const Projection* projection) {m_projection = projection;}
+
+		//Containers skipped by a projection are jumped over with the index rather than scanned.  indexed_src
+		//is the start of the source the index was built from.
+		void set_skip_index(const SkipIndex* skip_index, const char* indexed_src)
+		{
+			m_skip_index = skip_index;
+			m_indexed_src = indexed_src;
+		}
+
+	private:
+		template<bool Projected>
+		void _parse(const char* begin, const char* end);
+
+		//Projected parsing only, where the value following a key is headed
+		int _next_node() const {return m_builder.in_object() ? m_member_node : m_nodes.back();}
+		bool _keeps_scalar() const {return m_builder.in_object() || m_nodes.back() == Projection::c_KEEP_ALL;}
+
+		VariantBuilder m_builder;
+		const Projection* m_projection = nullptr;
+		const SkipIndex* m_skip_index = nullptr;
+		const char* m_indexed_src = nullptr;
+		std::vector<int> m_nodes; //projection node of each open container
+		int m_member_node = Projection::c_KEEP_ALL; //node of the value following the current key
+	};
+}
@@ -0,0 +1,73 @@
+/*
+ * SkipIndex.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "SkipIndex.hpp"
+
+#include <cassert>
+
+using namespace MJSON;
+
+void SkipIndex::build(const char* src, std::size_t length)
+{
+	StructuralIndex structural_index;
+	structural_index.build(src, length);
+	build(src, structural_index);
+}
+
+void SkipIndex::build(const char* src, const StructuralIndex& structural_index)
+{
+	m_opens.clear();
+	m_closes.clear();
+	m_next.clear();
+	m_stack.clear();
+
+	for(uint32_t position : structural_index.get_positions())
+	{
+		switch(src[position])
+		{
+		case '{':
+		case '[':
+			m_stack.push_back((uint32_t)m_opens.size());
+			m_opens.push_back(position);
+			m_closes.push_back(position); //replaced once its close is found
+			m_next.push_back(0);
+			break;
+		case '}':
+		case ']':
+			assert(!m_stack.empty() && src[m_opens[m_stack.back()]] == (src[position] == '}' ? '{' : '[') && "Container end does not match its start\n");
+			if(m_stack.empty())
+				return;
+			m_closes[m_stack.back()] = position;
+			m_next[m_stack.back()] = (uint32_t)m_opens.size();
+			m_stack.pop_back();
+			break;
+		default:
+			break;
+		}
+	}
+	assert(m_stack.empty() && "Unterminated container found\n");
+}
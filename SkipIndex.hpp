@@ -0,0 +1,102 @@
+/*
+ * SkipIndex.hpp
+ * The offset of the matching close for every '{' and '[' in a source, found from its StructuralIndex.
+ * Lets a container be skipped without scanning its contents.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "StructuralIndex.hpp"
+#include "Tokeniser.hpp"
+
+namespace MJSON
+{
+	//Opens are recorded in source order, so a lookup is a binary search over the containers rather than a
+	//scan over the characters of the one being skipped.  Callers stepping through siblings can pass a hint,
+	//which is checked first and updated to the container after the one skipped, making each skip O(1).
+	//12 bytes are stored per container.
+	class SkipIndex
+	{
+	public:
+		void build(const char* src, std::size_t length); //runs its own structural scan
+		void build(const char* src, const StructuralIndex& structural_index); //reuses an index already built for src
+
+		std::size_t size() const {return m_opens.size();}
+		bool empty() const {return m_opens.empty();}
+
+		//src is the start of the indexed source.  Returns past the close matching the bracket at open,
+		//nullptr if open is not an indexed '{' or '['.
+		const char* find_container_end(const char* src, const char* open) const
+		{
+			std::size_t hint = 0;
+			return find_container_end(src, open, hint);
+		}
+		const char* find_container_end(const char* src, const char* open, std::size_t& hint) const;
+
+		//As Tokeniser::find_value_end, but containers are skipped with the index
+		const char* find_value_end(const char* src, const char* cursor, const char* end) const
+		{
+			std::size_t hint = 0;
+			return find_value_end(src, cursor, end, hint);
+		}
+		const char* find_value_end(const char* src, const char* cursor, const char* end, std::size_t& hint) const;
+
+	private:
+		std::vector<uint32_t> m_opens; //offset of each '{' and '['
+		std::vector<uint32_t> m_closes; //offset of the matching '}' or ']'
+		std::vector<uint32_t> m_next; //index of the first container opened after each one closes
+		std::vector<uint32_t> m_stack; //indices of open containers while building
+	};
+
+	inline const char* SkipIndex::find_container_end(const char* src, const char* open, std::size_t& hint) const
+	{
+		const uint32_t offset = (uint32_t)(open - src);
+		std::size_t idx = hint;
+		if(idx >= m_opens.size() || m_opens[idx] != offset)
+		{
+			idx = std::lower_bound(m_opens.begin(), m_opens.end(), offset) - m_opens.begin();
+			if(idx == m_opens.size() || m_opens[idx] != offset)
+				return nullptr;
+		}
+		hint = m_next[idx];
+		return src + m_closes[idx] + 1;
+	}
+
+	inline const char* SkipIndex::find_value_end(const char* src, const char* cursor, const char* end, std::size_t& hint) const
+	{
+		if(*cursor == '{' || *cursor == '[')
+		{
+			const char* container_end = find_container_end(src, cursor, hint);
+			if(container_end != nullptr)
+				return container_end;
+		}
+		return Tokeniser::find_value_end(cursor, end);
+	}
+}
@@ -0,0 +1,136 @@
+/*
+ * StringRef.hpp
+ * Non owning reference to a run of characters, usually inside the JSON source.  Stands in for
+ * std::string_view as the library only requires C++ 14.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+
+namespace MJSON
+{
+	class StringRef
+	{
+	public:
+		StringRef() = default;
+
+		constexpr StringRef(const char* data, std::size_t size):
+			m_data(data), m_size(size)
+		{}
+
+		StringRef(const char* begin, const char* end):
+			m_data(begin), m_size(end - begin)
+		{}
+
+		StringRef(const char* c_str):
+			m_data(c_str), m_size(std::strlen(c_str))
+		{}
+
+		template<typename Alloc>
+		StringRef(const std::basic_string<char, std::char_traits<char>, Alloc>& s):
+			m_data(s.data()), m_size(s.size())
+		{}
+
+		constexpr const char* data() const {return m_data;}
+		constexpr std::size_t size() const {return m_size;}
+		constexpr bool empty() const {return m_size == 0;}
+
+		const char* begin() const {return m_data;}
+		const char* end() const {return m_data + m_size;}
+
+		char operator[](std::size_t idx) const {return m_data[idx];}
+
+		std::string to_string() const {return std::string(m_data, m_size);}
+
+		bool contains(char c) const
+		{
+			return m_size > 0 && std::memchr(m_data, c, m_size) != nullptr;
+		}
+
+		bool operator==(const StringRef& other) const
+		{
+			return m_size == other.m_size && (m_size == 0 || std::memcmp(m_data, other.m_data, m_size) == 0);
+		}
+
+		bool operator!=(const StringRef& other) const {return !(*this == other);}
+
+		std::size_t hash() const;
+
+	private:
+		const char* m_data = nullptr;
+		std::size_t m_size = 0;
+	};
+
+	//FNV-1a, used for every string keyed table in the library
+	constexpr std::size_t hash_string(const char* data, std::size_t size)
+	{
+		uint64_t hash = 14695981039346656037ULL;
+		for(std::size_t idx = 0; idx < size; idx++)
+		{
+			hash ^= static_cast<unsigned char>(data[idx]);
+			hash *= 1099511628211ULL;
+		}
+		return static_cast<std::size_t>(hash);
+	}
+
+	inline std::size_t StringRef::hash() const
+	{
+		return hash_string(m_data, m_size);
+	}
+
+	//A key known at compile time, such as a member name used in a per entity loop.  Its hash is computed
+	//by the compiler, so lookups taking a StaticKey skip hashing the key:
+	//	static constexpr StaticKey c_POSITION("m_position");
+	class StaticKey
+	{
+	public:
+		template<std::size_t N>
+		constexpr explicit StaticKey(const char (&literal)[N]):
+			m_data(literal), m_size(N - 1), m_hash(hash_string(literal, N - 1))
+		{}
+
+		constexpr StringRef get_string() const {return StringRef(m_data, m_size);}
+		constexpr std::size_t size() const {return m_size;}
+		constexpr std::size_t hash() const {return m_hash;}
+
+	private:
+		const char* m_data;
+		std::size_t m_size;
+		std::size_t m_hash;
+	};
+
+	struct StringRefHash
+	{
+		template<typename String>
+		std::size_t operator()(const String& s) const
+		{
+			return hash_string(s.data(), s.size());
+		}
+	};
+}
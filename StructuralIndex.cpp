@@ -0,0 +1,442 @@
+/*
+ * StructuralIndex.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "StructuralIndex.hpp"
+#include "MJSONEnums.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MJSON_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MJSON_TARGET_AVX2 __attribute__((target("avx2")))
+#define MJSON_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define MJSON_TARGET_AVX2
+#define MJSON_TARGET_SSE2
+#endif
+
+using namespace MJSON;
+
+using e_char = Enums::e_char;
+using e_implementation = StructuralIndex::e_implementation;
+using BlockMasks = StructuralIndex::BlockMasks;
+
+constexpr std::size_t StructuralIndex::c_MIN_CHUNK_SIZE;
+
+namespace
+{
+	inline int trailing_zeros(uint64_t bits)
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long idx;
+		_BitScanForward64(&idx, bits);
+		return (int)idx;
+#elif defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctzll(bits);
+#else
+		int idx = 0;
+		while(!(bits & 1))
+		{
+			bits >>= 1;
+			idx++;
+		}
+		return idx;
+#endif
+	}
+
+	inline int count_bits(uint64_t bits)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_popcountll(bits);
+#else
+		int count = 0;
+		for(; bits; count++)
+			bits &= bits - 1;
+		return count;
+#endif
+	}
+
+	//Each bit becomes the xor of itself and all bits below it, so bits between pairs of quotes are set.
+	inline uint64_t prefix_xor(uint64_t bits)
+	{
+		bits ^= bits << 1;
+		bits ^= bits << 2;
+		bits ^= bits << 4;
+		bits ^= bits << 8;
+		bits ^= bits << 16;
+		bits ^= bits << 32;
+		return bits;
+	}
+
+	void classify_block_scalar(const char* block, BlockMasks& masks)
+	{
+		masks = BlockMasks {0, 0, 0, 0};
+		for(std::size_t idx = 0; idx < StructuralIndex::c_BLOCK_SIZE; idx++)
+		{
+			uint64_t bit = uint64_t(1) << idx;
+			switch(Enums::char_to_e_char(block[idx]))
+			{
+			case e_char::BRACE_OPEN:
+			case e_char::BRACE_CLOSE:
+			case e_char::BRACKET_OPEN:
+			case e_char::BRACKET_CLOSE:
+			case e_char::COLON:
+			case e_char::COMMA:
+				masks.m_operator |= bit;
+				break;
+			case e_char::QUOTE:
+				masks.m_quote |= bit;
+				break;
+			case e_char::WHITESPACE:
+			case e_char::NEWLINE:
+				masks.m_whitespace |= bit;
+				break;
+			default:
+				if(block[idx] == '\\')
+					masks.m_backslash |= bit;
+				break;
+			}
+		}
+	}
+
+#ifdef MJSON_X86
+	//'{' and '[' (and '}' and ']') only differ by 0x20, so or-ing 0x20 lets one compare find both.
+	MJSON_TARGET_SSE2 void classify_block_sse2(const char* block, BlockMasks& masks)
+	{
+		const __m128i quote = _mm_set1_epi8('"');
+		const __m128i backslash = _mm_set1_epi8('\\');
+		const __m128i case_bit = _mm_set1_epi8(0x20);
+		const __m128i brace_open = _mm_set1_epi8('{');
+		const __m128i brace_close = _mm_set1_epi8('}');
+		const __m128i colon = _mm_set1_epi8(':');
+		const __m128i comma = _mm_set1_epi8(',');
+		const __m128i space = _mm_set1_epi8(' ');
+		const __m128i tab = _mm_set1_epi8('\t');
+		const __m128i newline = _mm_set1_epi8('\n');
+		const __m128i carriage_return = _mm_set1_epi8('\r');
+
+		masks = BlockMasks {0, 0, 0, 0};
+		for(int lane = 0; lane < 4; lane++)
+		{
+			__m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + lane * 16));
+			__m128i folded = _mm_or_si128(chars, case_bit);
+			__m128i op = _mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi8(folded, brace_open), _mm_cmpeq_epi8(folded, brace_close)),
+					_mm_or_si128(_mm_cmpeq_epi8(chars, colon), _mm_cmpeq_epi8(chars, comma)));
+			__m128i ws = _mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi8(chars, space), _mm_cmpeq_epi8(chars, tab)),
+					_mm_or_si128(_mm_cmpeq_epi8(chars, newline), _mm_cmpeq_epi8(chars, carriage_return)));
+
+			int shift = lane * 16;
+			masks.m_quote |= uint64_t((uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chars, quote))) << shift;
+			masks.m_backslash |= uint64_t((uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chars, backslash))) << shift;
+			masks.m_operator |= uint64_t((uint16_t)_mm_movemask_epi8(op)) << shift;
+			masks.m_whitespace |= uint64_t((uint16_t)_mm_movemask_epi8(ws)) << shift;
+		}
+	}
+
+	MJSON_TARGET_AVX2 void classify_block_avx2(const char* block, BlockMasks& masks)
+	{
+		const __m256i quote = _mm256_set1_epi8('"');
+		const __m256i backslash = _mm256_set1_epi8('\\');
+		const __m256i case_bit = _mm256_set1_epi8(0x20);
+		const __m256i brace_open = _mm256_set1_epi8('{');
+		const __m256i brace_close = _mm256_set1_epi8('}');
+		const __m256i colon = _mm256_set1_epi8(':');
+		const __m256i comma = _mm256_set1_epi8(',');
+		const __m256i space = _mm256_set1_epi8(' ');
+		const __m256i tab = _mm256_set1_epi8('\t');
+		const __m256i newline = _mm256_set1_epi8('\n');
+		const __m256i carriage_return = _mm256_set1_epi8('\r');
+
+		masks = BlockMasks {0, 0, 0, 0};
+		for(int lane = 0; lane < 2; lane++)
+		{
+			__m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + lane * 32));
+			__m256i folded = _mm256_or_si256(chars, case_bit);
+			__m256i op = _mm256_or_si256(
+					_mm256_or_si256(_mm256_cmpeq_epi8(folded, brace_open), _mm256_cmpeq_epi8(folded, brace_close)),
+					_mm256_or_si256(_mm256_cmpeq_epi8(chars, colon), _mm256_cmpeq_epi8(chars, comma)));
+			__m256i ws = _mm256_or_si256(
+					_mm256_or_si256(_mm256_cmpeq_epi8(chars, space), _mm256_cmpeq_epi8(chars, tab)),
+					_mm256_or_si256(_mm256_cmpeq_epi8(chars, newline), _mm256_cmpeq_epi8(chars, carriage_return)));
+
+			int shift = lane * 32;
+			masks.m_quote |= uint64_t((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, quote))) << shift;
+			masks.m_backslash |= uint64_t((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, backslash))) << shift;
+			masks.m_operator |= uint64_t((uint32_t)_mm256_movemask_epi8(op)) << shift;
+			masks.m_whitespace |= uint64_t((uint32_t)_mm256_movemask_epi8(ws)) << shift;
+		}
+	}
+#endif
+
+	//Find characters escaped by a backslash.  A run of backslashes escapes the following character
+	//only if the run has an odd length, so runs are split by whether they start on an odd or even bit.
+	inline uint64_t find_escaped(uint64_t backslash_mask, uint64_t& escaped_carry)
+	{
+		const uint64_t even_bits = 0x5555555555555555ULL;
+		uint64_t backslash = backslash_mask & ~escaped_carry;
+		uint64_t follows_escape = (backslash << 1) | escaped_carry;
+		uint64_t odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+		uint64_t sequences_starting_on_even_bits = odd_sequence_starts + backslash;
+		escaped_carry = sequences_starting_on_even_bits < odd_sequence_starts ? 1 : 0; //overflow means the run continues into the next block
+		uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+		return (even_bits ^ invert_mask) & follows_escape;
+	}
+
+	//Backslashes only appear in strings, so the byte at offset is escaped if an odd run of them precedes it
+	bool is_escaped(const char* src, std::size_t offset)
+	{
+		std::size_t run = 0;
+		while(run < offset && src[offset - run - 1] == '\\')
+			run++;
+		return (run & 1) != 0;
+	}
+
+	//Matches the scalar mask of _structurals_from_masks for the byte before offset
+	bool follows_scalar(const char* src, std::size_t offset)
+	{
+		if(offset == 0)
+			return false;
+		switch(src[offset - 1])
+		{
+		case '{': case '}': case '[': case ']': case ':': case ',':
+		case ' ': case '\t': case '\n': case '\r':
+			return false;
+		case '"':
+			return is_escaped(src, offset - 1);
+		default:
+			return true;
+		}
+	}
+
+	using ClassifyBlock_t = void (*)(const char*, BlockMasks&);
+
+	ClassifyBlock_t get_classifier(e_implementation impl)
+	{
+#ifdef MJSON_X86
+		if(impl == e_implementation::AVX2)
+			return classify_block_avx2;
+		if(impl == e_implementation::SSE2)
+			return classify_block_sse2;
+#endif
+		return classify_block_scalar;
+	}
+
+	e_implementation detect_implementation()
+	{
+#if defined(MJSON_X86) && (defined(__GNUC__) || defined(__clang__))
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("avx2"))
+			return e_implementation::AVX2;
+		if(__builtin_cpu_supports("sse2"))
+			return e_implementation::SSE2;
+#elif defined(MJSON_X86) && defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+		bool os_saves_ymm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 6) == 6);
+		bool has_sse2 = (info[3] & (1 << 26)) != 0;
+		__cpuidex(info, 7, 0);
+		if(os_saves_ymm && (info[1] & (1 << 5)))
+			return e_implementation::AVX2;
+		if(has_sse2)
+			return e_implementation::SSE2;
+#endif
+		return e_implementation::SCALAR;
+	}
+}
+
+e_implementation StructuralIndex::get_implementation()
+{
+	static const e_implementation implementation = detect_implementation();
+	return implementation;
+}
+
+void StructuralIndex::build(const char* src, std::size_t length)
+{
+	assert(length < UINT32_MAX && "Source too large, positions are stored as 32 bit offsets\n");
+
+	BlockCarry carry;
+	m_positions.clear();
+	_build_range(src, 0, length, length, carry, m_positions);
+	assert(carry.m_in_string == 0 && "Unterminated string found\n");
+}
+
+//Each chunk's starting carry is found without scanning everything before it.  Whether its first byte is
+//escaped, or follows a number or literal, only depends on the bytes just before it.  Whether it starts
+//inside a string depends on the parity of the quotes in all earlier chunks, which a first parallel pass
+//counts.  The second pass then indexes every chunk independently.
+void StructuralIndex::build(const char* src, std::size_t length, ThreadPool& thread_pool)
+{
+	assert(length < UINT32_MAX && "Source too large, positions are stored as 32 bit offsets\n");
+
+	const std::size_t max_chunks = std::min(thread_pool.get_thread_count(), length / c_MIN_CHUNK_SIZE);
+	if(max_chunks < 2)
+	{
+		build(src, length);
+		return;
+	}
+
+	const std::size_t chunk_size = (length / max_chunks + c_BLOCK_SIZE - 1) / c_BLOCK_SIZE * c_BLOCK_SIZE; //whole blocks
+	const std::size_t num_chunks = (length + chunk_size - 1) / chunk_size;
+	m_chunks.resize(num_chunks);
+
+	thread_pool.run(num_chunks, [&](std::size_t chunk_idx)
+	{
+		Chunk& chunk = m_chunks[chunk_idx];
+		chunk.m_begin = chunk_idx * chunk_size;
+		chunk.m_end = std::min(chunk.m_begin + chunk_size, length);
+		chunk.m_carry = BlockCarry();
+		chunk.m_carry.m_escaped = is_escaped(src, chunk.m_begin) ? 1 : 0;
+		chunk.m_carry.m_scalar = follows_scalar(src, chunk.m_begin) ? 1 : 0;
+		chunk.m_odd_quotes = _has_odd_quotes(src, chunk.m_begin, chunk.m_end, length, chunk.m_carry.m_escaped);
+	});
+
+	uint64_t in_string = 0;
+	for(Chunk& chunk : m_chunks)
+	{
+		chunk.m_carry.m_in_string = in_string;
+		if(chunk.m_odd_quotes)
+			in_string = ~in_string;
+	}
+	assert(in_string == 0 && "Unterminated string found\n");
+
+	thread_pool.run(num_chunks, [&](std::size_t chunk_idx)
+	{
+		Chunk& chunk = m_chunks[chunk_idx];
+		BlockCarry carry = chunk.m_carry;
+		chunk.m_positions.clear();
+		_build_range(src, chunk.m_begin, chunk.m_end, length, carry, chunk.m_positions);
+	});
+
+	std::size_t num_positions = 0;
+	for(Chunk& chunk : m_chunks)
+	{
+		chunk.m_first_position = num_positions;
+		num_positions += chunk.m_positions.size();
+	}
+	m_positions.resize(num_positions);
+	thread_pool.run(num_chunks, [&](std::size_t chunk_idx)
+	{
+		const Chunk& chunk = m_chunks[chunk_idx];
+		if(!chunk.m_positions.empty())
+			std::memcpy(m_positions.data() + chunk.m_first_position, chunk.m_positions.data(), chunk.m_positions.size() * sizeof(uint32_t));
+	});
+}
+
+//begin must be a multiple of c_BLOCK_SIZE, end either one too or the end of the source
+void StructuralIndex::_build_range(const char* src, std::size_t begin, std::size_t end, std::size_t length, BlockCarry& carry, std::vector<uint32_t>& positions)
+{
+	ClassifyBlock_t classify = get_classifier(m_implementation);
+	BlockMasks masks;
+
+	std::size_t offset = begin;
+	for(; offset + c_BLOCK_SIZE <= end; offset += c_BLOCK_SIZE)
+	{
+		classify(src + offset, masks);
+		_append_positions(_structurals_from_masks(masks, carry), (uint32_t)offset, positions);
+	}
+
+	if(offset < end) //pad the final partial block with whitespace
+	{
+		assert(end == length && "Only the final block of the source may be partial\n");
+		(void)length;
+		char last_block[c_BLOCK_SIZE];
+		std::memset(last_block, ' ', c_BLOCK_SIZE);
+		std::memcpy(last_block, src + offset, end - offset);
+		classify(last_block, masks);
+		_append_positions(_structurals_from_masks(masks, carry), (uint32_t)offset, positions);
+	}
+}
+
+bool StructuralIndex::_has_odd_quotes(const char* src, std::size_t begin, std::size_t end, std::size_t length, uint64_t escaped_carry)
+{
+	ClassifyBlock_t classify = get_classifier(m_implementation);
+	BlockMasks masks;
+	int quotes = 0;
+
+	std::size_t offset = begin;
+	for(; offset + c_BLOCK_SIZE <= end; offset += c_BLOCK_SIZE)
+	{
+		classify(src + offset, masks);
+		quotes += count_bits(masks.m_quote & ~find_escaped(masks.m_backslash, escaped_carry));
+	}
+
+	if(offset < end)
+	{
+		assert(end == length && "Only the final block of the source may be partial\n");
+		(void)length;
+		char last_block[c_BLOCK_SIZE];
+		std::memset(last_block, ' ', c_BLOCK_SIZE);
+		std::memcpy(last_block, src + offset, end - offset);
+		classify(last_block, masks);
+		quotes += count_bits(masks.m_quote & ~find_escaped(masks.m_backslash, escaped_carry));
+	}
+	return (quotes & 1) != 0;
+}
+
+uint64_t StructuralIndex::_structurals_from_masks(const BlockMasks& masks, BlockCarry& carry)
+{
+	uint64_t escaped = find_escaped(masks.m_backslash, carry.m_escaped);
+
+	uint64_t quote = masks.m_quote & ~escaped;
+	uint64_t in_string = prefix_xor(quote) ^ carry.m_in_string; //includes the opening quote, excludes the closing one
+	carry.m_in_string = uint64_t((int64_t)in_string >> 63);
+
+	//A number or literal starts at any non whitespace, non operator character that does not follow another one
+	uint64_t scalar = ~(masks.m_operator | masks.m_whitespace | quote);
+	uint64_t follows_scalar = (scalar << 1) | carry.m_scalar;
+	carry.m_scalar = scalar >> 63;
+	uint64_t scalar_start = scalar & ~follows_scalar;
+
+	return ((masks.m_operator | scalar_start) & ~in_string) | (quote & in_string);
+}
+
+void StructuralIndex::_append_positions(uint64_t structurals, uint32_t block_offset, std::vector<uint32_t>& positions)
+{
+	if(structurals == 0)
+		return;
+
+	std::size_t idx = positions.size();
+	positions.resize(idx + count_bits(structurals));
+	uint32_t* out = positions.data() + idx;
+	while(structurals)
+	{
+		*out++ = block_offset + trailing_zeros(structurals);
+		structurals &= structurals - 1;
+	}
+}
@@ -0,0 +1,98 @@
+/*
+ * StructuralIndex.hpp
+ * First stage of tokenising.  Scans the source in 64 byte blocks and records the position of every
+ * structural character ({}[]:,), every opening quote and the first character of every number/literal.
+ * The tokeniser then only has to visit those positions.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace MJSON
+{
+	class ThreadPool;
+
+	class StructuralIndex
+	{
+	public:
+
+		enum class e_implementation { SCALAR, SSE2, AVX2 };
+
+		static constexpr std::size_t c_BLOCK_SIZE = 64;
+
+		//Masks for one 64 byte block, bit n refers to byte n of the block.
+		struct BlockMasks
+		{
+			uint64_t m_quote;
+			uint64_t m_backslash;
+			uint64_t m_operator; //{}[]:,
+			uint64_t m_whitespace;
+		};
+
+		void build(const char* src, std::size_t length);
+		void build(const char* src, std::size_t length, ThreadPool& thread_pool); //scans chunks of a large source concurrently, same result
+
+		std::size_t size() const {return m_positions.size();}
+		uint32_t operator[](std::size_t idx) const {return m_positions[idx];}
+		const std::vector<uint32_t>& get_positions() const {return m_positions;}
+
+		static e_implementation get_implementation(); //best kernel supported by the running cpu, detected once
+		void set_implementation(e_implementation impl) {m_implementation = impl;} //override, mainly for testing the kernels against each other
+
+	private:
+		//State carried from one block to the next
+		struct BlockCarry
+		{
+			uint64_t m_escaped = 0; //1 if the first byte of the next block is escaped by a backslash
+			uint64_t m_in_string = 0; //all ones if the next block starts inside a string
+			uint64_t m_scalar = 0; //1 if the last byte of the block was part of a number/literal
+		};
+
+		//A slice of the source scanned by one thread
+		struct Chunk
+		{
+			std::size_t m_begin;
+			std::size_t m_end;
+			BlockCarry m_carry; //state at m_begin
+			bool m_odd_quotes;
+			std::size_t m_first_position; //of this chunk's positions within m_positions
+			std::vector<uint32_t> m_positions;
+		};
+
+		static constexpr std::size_t c_MIN_CHUNK_SIZE = 64 * 1024;
+
+		void _build_range(const char* src, std::size_t begin, std::size_t end, std::size_t length, BlockCarry& carry, std::vector<uint32_t>& positions);
+		bool _has_odd_quotes(const char* src, std::size_t begin, std::size_t end, std::size_t length, uint64_t escaped_carry); //unescaped quotes only
+		uint64_t _structurals_from_masks(const BlockMasks& masks, BlockCarry& carry);
+		static void _append_positions(uint64_t structurals, uint32_t block_offset, std::vector<uint32_t>& positions);
+
+		std::vector<uint32_t> m_positions;
+		std::vector<Chunk> m_chunks; //retained between builds
+		e_implementation m_implementation = get_implementation();
+	};
+}
@@ -0,0 +1,108 @@
+/*
+ * ThreadPool.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+using namespace MJSON;
+
+ThreadPool::ThreadPool(std::size_t num_threads)
+{
+	if(num_threads == 0)
+		num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+	for(std::size_t idx = 1; idx < num_threads; idx++)
+	{
+		m_workers.emplace_back(&ThreadPool::_worker_loop, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_wake.notify_all();
+	for(auto& worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+void ThreadPool::run(std::size_t num_tasks, const Task_t& task)
+{
+	if(num_tasks == 0)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_task = &task;
+		m_num_tasks = num_tasks;
+		m_next_task = 0;
+		m_busy_workers = m_workers.size();
+		m_generation++;
+	}
+	m_wake.notify_all();
+
+	_run_tasks();
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done.wait(lock, [this]() {return m_busy_workers == 0;});
+	m_task = nullptr;
+}
+
+void ThreadPool::_worker_loop()
+{
+	uint64_t last_generation = 0;
+	while(true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [&]() {return m_stopping || m_generation != last_generation;});
+			if(m_stopping)
+				return;
+			last_generation = m_generation;
+		}
+
+		_run_tasks();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(--m_busy_workers == 0)
+			m_done.notify_one();
+	}
+}
+
+void ThreadPool::_run_tasks()
+{
+	const Task_t& task = *m_task;
+	for(std::size_t idx = m_next_task++; idx < m_num_tasks; idx = m_next_task++)
+	{
+		task(idx);
+	}
+}
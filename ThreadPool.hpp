@@ -0,0 +1,74 @@
+/*
+ * ThreadPool.hpp
+ * Fixed set of worker threads for running a batch of independent tasks in parallel.  The calling thread
+ * joins in, so a pool of one thread runs everything inline.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MJSON
+{
+	class ThreadPool
+	{
+	public:
+		using Task_t = std::function<void(std::size_t task_idx)>;
+
+		explicit ThreadPool(std::size_t num_threads = 0); //0 uses one thread per hardware thread
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		std::size_t get_thread_count() const {return m_workers.size() + 1;}
+
+		//Calls task(0) to task(num_tasks - 1) across the threads, returning once all have finished.
+		//Tasks are handed out in order but may complete in any order.
+		void run(std::size_t num_tasks, const Task_t& task);
+
+	private:
+		void _worker_loop();
+		void _run_tasks();
+
+		std::vector<std::thread> m_workers;
+		std::mutex m_mutex;
+		std::condition_variable m_wake;
+		std::condition_variable m_done;
+
+		const Task_t* m_task = nullptr;
+		std::size_t m_num_tasks = 0;
+		std::atomic<std::size_t> m_next_task {0};
+		std::size_t m_busy_workers = 0;
+		uint64_t m_generation = 0; //incremented by every run, so workers can tell a new batch from a spurious wake
+		bool m_stopping = false;
+	};
+}
@@ -25,31 +25,34 @@
  ******************************************************************************************************
  */
 #include <string>
+#include <cstdint>
 
 #include "MJSONEnums.hpp"
+#include "StringRef.hpp"
 
 #pragma once
 
 namespace MJSON
 {
+	//Tokens do not hold a copy of their value, only where it sits within the JSON source.
+	//For keys and strings this excludes the quotes.  Kept as a 12 byte POD so a TokenList is one
+	//contiguous block.
 	struct Token
 	{
-		~Token(){};
+		uint32_t m_offset;
+		uint32_t m_length;
 		Enums::e_token m_type;
-		std::string m_value;
 
-		void operator=(const Token& t)
+		StringRef get_value(const char* json_src) const
 		{
-			m_type = t.m_type;
-			m_value = t.m_value;
+			return StringRef(json_src + m_offset, m_length);
 		}
 
-		std::string to_string()
+		std::string to_string(const char* json_src) const
 		{
-			return "Token{" + Enums::e_token_to_string(m_type) + "," + m_value + "}";
+			return "Token{" + Enums::e_token_to_string(m_type) + "," + get_value(json_src).to_string() + "}";
 		}
 
 
 	};
 }
-
@@ -34,38 +34,17 @@
 
 using namespace MJSON;
 
-void TokenList::init(int size)
+void TokenList::init(std::size_t estimated_size, const char* json_src)
 {
-	m_tokens.reserve(size);
-
-	for(auto idx = 0; idx < m_tokens.capacity(); idx ++)
-	{
-		m_tokens.push_back(std::make_unique<Token>());
-	}
-}
-void TokenList::add_token(Enums::e_token type, std::string value)
-{
-	assert(m_tokens.capacity() > 0 && "Storage not initialised.  Must call TokenList::init(int size) before adding tokens\n");
-	m_tokens[m_current_idx]->m_type = type;
-	if(value != "")
-		m_tokens[m_current_idx]->m_value = value;
-	//std::cout << "TokenList::add_token: " << value << "\n";
-	m_current_idx++;
-}
-
-void TokenList::clear_unused()
-{
-	if(m_current_idx < m_tokens.size() - 1)
-	{
-		m_tokens.resize(m_current_idx);
-	}
-
+	m_json_src = json_src;
+	m_tokens.clear();
+	m_tokens.reserve(estimated_size);
 }
 
 void TokenList::print_tokens() const
 {
 	for(auto& token : m_tokens)
 	{
-		std::cout << token->to_string() << "\n";
+		std::cout << token.to_string(m_json_src) << "\n";
 	}
 }
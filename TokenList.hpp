@@ -39,20 +39,32 @@ namespace MJSON
 	class TokenList
 	{
 	public:
-		void init(int size);
-		void add_token(Enums::e_token type, std::string value = "");
-		void clear_unused();
+		void init(std::size_t estimated_size, const char* json_src); //clears the list, reserving space for the estimated number of tokens
+		void add_token(Enums::e_token type, uint32_t offset = 0, uint32_t length = 0)
+		{
+			m_tokens.push_back(Token {offset, length, type});
+		}
+
+		//Appends count tokens for the caller to fill in, such as tokens produced on several threads
+		Token* add_tokens(std::size_t count)
+		{
+			std::size_t first = m_tokens.size();
+			m_tokens.resize(first + count);
+			return m_tokens.data() + first;
+		}
+
+		StringRef get_value(const Token& token) const {return token.get_value(m_json_src);}
 
 		void print_tokens() const;
-		int size()const {return m_tokens.size();}
+		int size()const {return (int)m_tokens.size();}
 
-		Token* operator[](const int & idx)
+		const Token& operator[](const int & idx) const
 		{
-			return m_tokens[idx].get();
+			return m_tokens[idx];
 		}
 	private:
-		std::vector<std::unique_ptr<Token>> m_tokens;
-		int m_current_idx = 0;
+		std::vector<Token> m_tokens;
+		const char* m_json_src = nullptr; //source the token offsets refer to, must outlive the list
 	};
 }
 
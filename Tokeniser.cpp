@@ -26,7 +26,11 @@
  */
 
 #include "Tokeniser.hpp"
-#include <sstream>
+#include "SkipIndex.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstring>
 #include <cassert>
 
 using namespace MJSON;
@@ -34,206 +38,133 @@ using namespace MJSON;
 using e_char = Enums::e_char;
 using e_token = Enums::e_token;
 
-
-TokenList Tokeniser::get_token_list(std::string & json_src)
+namespace
 {
-	assert(json_src.size() > 0 && "Error, src length <  1");
-
-	TokenList tokens;
-	tokens.init(json_src.size() / 2);
-
-	char_idx_t idx = 0;
-
-	while(idx < json_src.size() - 1)
+	//Appends a token for each position in [first, last) to tokens, which is a TokenList or ChunkTokens
+	template<typename Tokens>
+	void tokenise_positions(const char* src, const char* end, const std::vector<uint32_t>& positions, std::size_t first, std::size_t last, Tokens& tokens)
 	{
-		Character current_character = get_next_character(json_src, idx);
-		e_char character_type = current_character.m_type;
-		idx = current_character.m_pos;
-
-
-		switch(character_type)
+		for(std::size_t idx = first; idx < last; idx++)
 		{
-		case e_char::BRACE_OPEN:
-			tokens.add_token(e_token::OBJECT_START);
-			break;
-		case e_char::BRACE_CLOSE:
-			tokens.add_token(e_token::OBJECT_END);
-			break;
-		case e_char::BRACKET_OPEN:
-			tokens.add_token(e_token::ARRAY_START);
-			break;
-		case e_char::BRACKET_CLOSE:
-			tokens.add_token(e_token::ARRAY_END); //TODO: Check if end of file (comma)
-			break;
-		case e_char::WHITESPACE:
-		case e_char::NEWLINE:
-		case e_char::COMMA:
-			break;
-
-		case e_char::QUOTE:
+			const char* cursor = src + positions[idx];
+
+			switch(Enums::char_to_e_char(*cursor))
 			{
-				StringPos str = get_string(json_src, idx);
-				idx = str.m_pos;
-				Character next_character = get_next_character(json_src,idx);
-				if(next_character.m_type == e_char::COLON) //must be a key if previous was a string
-				{
-					tokens.add_token(e_token::KEY, str.m_string);
-					idx = next_character.m_pos;
-				}
-				else if(next_character.m_type == e_char::COMMA || next_character.m_type == e_char::BRACE_CLOSE || next_character.m_type == e_char::BRACKET_CLOSE) //must be a string value as ", would indicate value, not key
-				{
-					tokens.add_token(e_token::STRING, str.m_string);
-				}
+			case e_char::BRACE_OPEN:
+				tokens.add_token(e_token::OBJECT_START);
 				break;
-			}
-		case e_char::LETTER:
-			{
-				idx --;
-				std::string next_four_chars = get_next_n_chars_as_string(json_src, 4, idx);
-				if(next_four_chars == "true")
-				{
-					tokens.add_token(e_token::BOOL, next_four_chars);
-					idx += 4;
-				}
-				else if(next_four_chars == "fals")
-				{
-					tokens.add_token(e_token::BOOL, get_next_n_chars_as_string(json_src, 5, idx));
-					idx += 5;
-				}
-				else if(next_four_chars == "null")
-				{
-					tokens.add_token(e_token::NULL_VALUE, next_four_chars);
-					idx += 4;
-				}
-				else
-				{
-					assert(false && "Character found at invalid position.  Not key, string, bool or null\n");
-				}
+			case e_char::BRACE_CLOSE:
+				tokens.add_token(e_token::OBJECT_END);
 				break;
-			}
-		case e_char::NUMBER:
-			{
-				//std::cout << "Number value\n";
-				idx --;
-				StringPos num_as_str = get_number_string(json_src, idx);
-				assert(num_as_str.m_string.substr(0, 1) != " " && "Leading whitespace, should have already been removed/ignored\n");
-
-				std::string clean_num_str = num_as_str.m_string;
-
-				if(clean_num_str.find(Enums::e_char_to_string(e_char::WHITESPACE)) != std::string::npos) //remove following whitespace
+			case e_char::BRACKET_OPEN:
+				tokens.add_token(e_token::ARRAY_START);
+				break;
+			case e_char::BRACKET_CLOSE:
+				tokens.add_token(e_token::ARRAY_END);
+				break;
+			case e_char::COMMA:
+			case e_char::COLON:
+				break;
+			case e_char::QUOTE:
 				{
-					clean_num_str = get_substr(clean_num_str, e_char::WHITESPACE, 0).m_string;
+					const char* str_start = cursor + 1;
+					const char* str_end = Tokeniser::find_string_end(str_start, end);
+					bool is_key = idx + 1 < positions.size() && src[positions[idx + 1]] == ':'; //must be a key if followed by a colon
+					tokens.add_token(is_key ? e_token::KEY : e_token::STRING, (uint32_t)(str_start - src), (uint32_t)(str_end - str_start));
+					break;
 				}
-				if(clean_num_str.find(Enums::e_char_to_string(e_char::NEWLINE)) != std::string::npos)
+			case e_char::LETTER:
 				{
-					clean_num_str = get_substr(clean_num_str, e_char::NEWLINE, 0).m_string;
+					const char* literal_end = Tokeniser::find_literal_end(cursor, end);
+					e_token type = (*cursor == 'n') ? e_token::NULL_VALUE : e_token::BOOL;
+					tokens.add_token(type, (uint32_t)(cursor - src), (uint32_t)(literal_end - cursor));
+					break;
 				}
-
-
-				std::string end_char = get_string_end_character(clean_num_str);
-
-				if(end_char == Enums::e_char_to_string(e_char::BRACKET_CLOSE) || end_char == Enums::e_char_to_string(e_char::BRACE_CLOSE))
-				{
-					clean_num_str = get_substr(clean_num_str, e_char::WHITESPACE, 0).m_string;
-					tokens.add_token(e_token::NUMBER, clean_num_str);
-					idx += clean_num_str.length();
-				}
-				else
+			case e_char::NUMBER:
 				{
-					tokens.add_token(e_token::NUMBER, clean_num_str);
-					idx += clean_num_str.length();
+					const char* number_end = Tokeniser::find_number_end(cursor, end);
+					tokens.add_token(e_token::NUMBER, (uint32_t)(cursor - src), (uint32_t)(number_end - cursor));
+					break;
 				}
+			default:
+				assert(false && "Invalid character found\n");
+				break;
 			}
 		}
-
-	}
-	tokens.clear_unused();
-	return tokens;
-}
-
-
-//Return char idx will be of the character following the aquired string
-Tokeniser::StringPos Tokeniser::get_string(std::string & json, char_idx_t current_char_idx)
-{
-	//std::cout << "get_string\n";
-	return get_substr(json, e_char::QUOTE,	current_char_idx);
-
-}
-
-Tokeniser::StringPos Tokeniser::get_number_string(std::string & json, char_idx_t current_char_idx)
-{
-	//std::cout << "get_number_string\n";
-	return get_substr(json, e_char::COMMA, current_char_idx);
-}
-
-Tokeniser::StringPos Tokeniser::get_substr(std::string& json, e_char delimiter, char_idx_t current_char_idx)
-{
-	//std::cout << "get_subtr\n";
-	std::string current_char = _get_char_at_idx(json, current_char_idx);
-
-	int str_len = 0;
-	do {
-		str_len += 1;
-		current_char = json.substr(current_char_idx + str_len, 1);
-
 	}
-	while( current_char_idx + str_len < json.size() - 1 && current_char != Enums::e_char_to_string(delimiter) );
 
+	struct ChunkTokens
+	{
+		void add_token(e_token type, uint32_t offset = 0, uint32_t length = 0)
+		{
+			m_tokens.push_back(Token {offset, length, type});
+		}
 
-	std::string string = json.substr(current_char_idx, str_len);
-	current_char_idx += str_len + 1;
-
-	return StringPos { string, current_char_idx };
+		std::vector<Token>& m_tokens;
+	};
 }
 
+constexpr std::size_t Tokeniser::c_MIN_CHUNK_POSITIONS;
 
-std::string Tokeniser::_get_char_at_idx(std::string& json, char_idx_t idx)
+TokenList Tokeniser::get_token_list(std::string & json_src, SkipIndex* skip_index)
 {
-	return json.substr(idx, 1);
+	TokenList tokens;
+	tokenise(json_src.data(), json_src.size(), tokens, skip_index);
+	return tokens;
 }
 
-std::string Tokeniser::get_next_n_chars_as_string(std::string & json, int num_chars, char_idx_t idx)
+void Tokeniser::tokenise(const char* src, std::size_t length, TokenList& tokens, SkipIndex* skip_index)
 {
-	return json.substr(idx, num_chars);
-}
+	assert(length > 0 && "Error, src length <  1");
 
+	const char* end = src + length;
 
-Tokeniser::Character Tokeniser::get_next_character(std::string & json, char_idx_t current_char_idx)
-{
-	//std::string current_char = _get_char_at_idx(json, current_char_idx);
-	std::string current_char;
-	do {
-			current_char = _get_char_at_idx(json, current_char_idx);
-			current_char_idx ++;
-	}
-	while(current_char == Enums::e_char_to_string(e_char::WHITESPACE) || current_char == Enums::e_char_to_string(e_char::NEWLINE));
-
-	if(c_LETTERS.find(current_char) != std::string::npos)
-	{
-		return Character { e_char::LETTER, current_char_idx};
-	}
-	else if(c_NUMBERS.find(current_char) != std::string::npos)
-	{
-		return Character{ e_char::NUMBER, current_char_idx};
-	}
+	if(m_thread_pool != nullptr)
+		m_structural_index.build(src, length, *m_thread_pool);
 	else
+		m_structural_index.build(src, length);
+	if(skip_index != nullptr)
+		skip_index->build(src, m_structural_index);
+	const std::vector<uint32_t>& positions = m_structural_index.get_positions();
+	const std::size_t num_positions = positions.size();
+
+	const std::size_t num_chunks = m_thread_pool != nullptr ? std::min(m_thread_pool->get_thread_count(), num_positions / c_MIN_CHUNK_POSITIONS) : 1;
+	if(num_chunks < 2)
 	{
-		assert(Enums::e_char_exists(current_char) && "Invalid character found\n");
-		return Character { Enums::string_to_e_char(current_char), current_char_idx};
+		tokens.init(num_positions, src); //every token starts at an indexed position, so this is an upper bound
+		tokenise_positions(src, end, positions, 0, num_positions, tokens);
+		return;
 	}
 
-}
-
-std::string Tokeniser::get_string_end_character(std::string & str)
-{
-	if(str.length() < 1)
-		return "";
-	if (str.find("\n") != std::string::npos)
+	//Each chunk of positions is tokenised into its own list, then the lists are copied in order
+	const std::size_t chunk_positions = (num_positions + num_chunks - 1) / num_chunks;
+	m_chunk_tokens.resize(num_chunks);
+	m_thread_pool->run(num_chunks, [&](std::size_t chunk_idx)
 	{
-		return str.substr(str.length() -2, 1);
-	}
-	else
+		std::vector<Token>& chunk_tokens = m_chunk_tokens[chunk_idx];
+		chunk_tokens.clear();
+		std::size_t first = chunk_idx * chunk_positions;
+		std::size_t last = std::min(first + chunk_positions, num_positions);
+		chunk_tokens.reserve(last - first);
+		ChunkTokens out {chunk_tokens};
+		tokenise_positions(src, end, positions, first, last, out);
+	});
+
+	std::size_t num_tokens = 0;
+	for(const std::vector<Token>& chunk_tokens : m_chunk_tokens)
+		num_tokens += chunk_tokens.size();
+	tokens.init(num_tokens, src);
+	Token* out = tokens.add_tokens(num_tokens);
+	std::vector<Token*> chunk_outputs(num_chunks);
+	for(std::size_t chunk_idx = 0; chunk_idx < num_chunks; chunk_idx++)
 	{
-		return str.substr(str.length() - 1,	1);
+		chunk_outputs[chunk_idx] = out;
+		out += m_chunk_tokens[chunk_idx].size();
 	}
+	m_thread_pool->run(num_chunks, [&](std::size_t chunk_idx)
+	{
+		const std::vector<Token>& chunk_tokens = m_chunk_tokens[chunk_idx];
+		if(!chunk_tokens.empty())
+			std::memcpy(chunk_outputs[chunk_idx], chunk_tokens.data(), chunk_tokens.size() * sizeof(Token));
+	});
 }
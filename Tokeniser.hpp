@@ -30,46 +30,148 @@
 #pragma once
 #include "MJSONEnums.hpp"
 #include "TokenList.hpp"
+#include "StructuralIndex.hpp"
 #include <string>
-#include <unordered_map>
+#include <cstring>
+#include <cassert>
 
 namespace MJSON
 {
 	using char_idx_t = std::string::size_type;
 
+	class SkipIndex;
+	class ThreadPool;
+
+	//Tokenising is done in two stages.  The StructuralIndex finds where every token starts using SIMD where
+	//available, then get_token_list visits only those positions, classifying each with c_CHAR_CLASS_TABLE.
+	//No strings are built at all, tokens record the offset and length of their value within the source.
 	class Tokeniser
 	{
 
 	public:
 
-		struct StringPos
+		Tokeniser() = default;
+
+		TokenList get_token_list(std::string & json_src, SkipIndex* skip_index = nullptr); //also fills skip_index from the same structural scan
+		void tokenise(const char* src, std::size_t length, TokenList& tokens, SkipIndex* skip_index = nullptr); //refills tokens, reusing its capacity
+
+		//Large sources are indexed and tokenised in chunks across the pool's threads.  nullptr, the default,
+		//tokenises on the calling thread.  The pool must outlive the tokeniser's use of it.
+		void set_thread_pool(ThreadPool* thread_pool) {m_thread_pool = thread_pool;}
+
+		//Scanning helpers operate on the range [cursor, end) and return the position following what was scanned.
+		static const char* skip_whitespace(const char* cursor, const char* end);
+		static const char* find_string_end(const char* cursor, const char* end); //cursor must follow the opening quote, returns the closing quote
+		static const char* find_number_end(const char* cursor, const char* end);
+		static const char* find_literal_end(const char* cursor, const char* end); //true, false or null
+		static const char* find_container_end(const char* cursor, const char* end); //cursor must be on the opening bracket, returns past the closing one
+		static const char* find_value_end(const char* cursor, const char* end); //any value, cursor must be on its first character
+
+		static bool is_number_char(char c);
+
+	private:
+		static constexpr std::size_t c_MIN_CHUNK_POSITIONS = 16 * 1024;
+
+		StructuralIndex m_structural_index;
+		ThreadPool* m_thread_pool = nullptr;
+		std::vector<std::vector<Token>> m_chunk_tokens; //per thread output, retained between sources
+	};
+
+	inline const char* Tokeniser::skip_whitespace(const char* cursor, const char* end)
+	{
+		while(cursor < end)
 		{
-			std::string m_string;
-			char_idx_t m_pos;
-		};
+			Enums::e_char c = Enums::char_to_e_char(*cursor);
+			if(c != Enums::e_char::WHITESPACE && c != Enums::e_char::NEWLINE)
+				break;
+			cursor++;
+		}
+		return cursor;
+	}
 
-		struct Character
+	inline const char* Tokeniser::find_string_end(const char* cursor, const char* end)
+	{
+		while(true)
 		{
-			Enums::e_char m_type;
-			char_idx_t m_pos;
-		};
+			const char* quote = static_cast<const char*>(std::memchr(cursor, '"', end - cursor));
+			assert(quote != nullptr && "Unterminated string found\n");
+			if(quote == nullptr)
+				return end;
 
-		const std::string c_LETTERS = "abcdefghijklmnopqrstuvwxyzABCEDFGHIJKLMNOPQRSTUVWXYZ";
-		const std::string c_NUMBERS = "-0123456789";
+			const char* backslash = quote; //the quote is escaped if preceded by an odd number of backslashes
+			while(backslash > cursor && *(backslash - 1) == '\\')
+				backslash--;
+			if(((quote - backslash) & 1) == 0)
+				return quote;
+			cursor = quote + 1;
+		}
+	}
 
-		Tokeniser() = default;
+	inline bool Tokeniser::is_number_char(char c)
+	{
+		Enums::e_char type = Enums::char_to_e_char(c);
+		return type == Enums::e_char::NUMBER || type == Enums::e_char::PERIOD || c == 'e' || c == 'E' || c == '+';
+	}
 
-		TokenList get_token_list(std::string & json_src);
+	inline const char* Tokeniser::find_number_end(const char* cursor, const char* end)
+	{
+		while(cursor < end && is_number_char(*cursor))
+			cursor++;
+		return cursor;
+	}
 
-		StringPos get_string(std::string & json, char_idx_t current_char_idx);
-		StringPos get_substr(std::string & json, Enums::e_char delimiter, char_idx_t current_char_idx );
-		StringPos get_number_string(std::string & json, char_idx_t current_char_idx);
-		std::string get_string_end_character(std::string &);
+	inline const char* Tokeniser::find_literal_end(const char* cursor, const char* end)
+	{
+		std::size_t remaining = end - cursor;
+		if(remaining >= 4 && (std::memcmp(cursor, "true", 4) == 0 || std::memcmp(cursor, "null", 4) == 0))
+			return cursor + 4;
+		if(remaining >= 5 && std::memcmp(cursor, "false", 5) == 0)
+			return cursor + 5;
+		assert(false && "Character found at invalid position.  Not key, string, bool or null\n");
+		return end;
+	}
 
-		Character get_next_character(std::string & json, char_idx_t current_char_idx);
-		std::string get_next_n_chars_as_string(std::string & json, int num_chars, char_idx_t current_char_idx);
+	inline const char* Tokeniser::find_container_end(const char* cursor, const char* end)
+	{
+		std::size_t depth = 0;
+		while(cursor < end)
+		{
+			switch(*cursor)
+			{
+			case '{':
+			case '[':
+				depth++;
+				break;
+			case '}':
+			case ']':
+				if(--depth == 0)
+					return cursor + 1;
+				break;
+			case '"':
+				cursor = find_string_end(cursor + 1, end);
+				break;
+			default:
+				break;
+			}
+			cursor++;
+		}
+		assert(false && "Unterminated container found\n");
+		return end;
+	}
 
-	private:
-		std::string _get_char_at_idx(std::string& json, char_idx_t);
-	};
+	inline const char* Tokeniser::find_value_end(const char* cursor, const char* end)
+	{
+		switch(Enums::char_to_e_char(*cursor))
+		{
+		case Enums::e_char::BRACE_OPEN:
+		case Enums::e_char::BRACKET_OPEN:
+			return find_container_end(cursor, end);
+		case Enums::e_char::QUOTE:
+			return find_string_end(cursor + 1, end) + 1;
+		case Enums::e_char::NUMBER:
+			return find_number_end(cursor, end);
+		default:
+			return find_literal_end(cursor, end);
+		}
+	}
 }
@@ -30,83 +30,126 @@
 using namespace MJSON;
 
 
-void VectorVariant::add_variant(Variant::type var_type, std::string& value_str, std::string key)
+Variant* ContainerVariant::_create_variant(Variant::type var_type, StringRef value_str, bool escaped)
 {
+	if(m_arena == nullptr)
+	{
+		switch(var_type)
+		{
+		case Variant::type::string_t: return new StringV(value_str, nullptr, escaped);
+		case Variant::type::bool_t: return new Bool(value_str);
+		case Variant::type::float_t: return new Float(value_str);
+		case Variant::type::int_t: return new Int(value_str);
+		case Variant::type::vector_t: return new VectorVariant(nullptr, m_key_pool);
+		case Variant::type::map_t: return new MapVariant(nullptr, m_key_pool);
+		default: return new Null();
+		}
+	}
+
 	switch(var_type)
 	{
-	case Variant::type::null_t:
-		m_container.push_back(std::make_unique<Null>());
-		break;
-	case Variant::type::string_t:
-		m_container.push_back(std::make_unique<StringV>(value_str));
-		break;
-	case Variant::type::bool_t:
-		m_container.push_back(std::make_unique<Bool>(value_str));
-		break;
-	case Variant::type::float_t:
-		m_container.push_back(std::make_unique<Float>(value_str));
-		break;
-	case Variant::type::int_t:
-		m_container.push_back(std::make_unique<Int>(value_str));
-		break;
-	case Variant::type::vector_t:
-		m_container.push_back(std::make_unique<VectorVariant>());
-		break;
-	case Variant::type::map_t:
-		m_container.push_back(std::make_unique<MapVariant>());
-		break;
+	case Variant::type::string_t: return m_arena->create<StringV>(value_str, m_arena, escaped);
+	case Variant::type::bool_t: return m_arena->create<Bool>(value_str);
+	case Variant::type::float_t: return m_arena->create<Float>(value_str);
+	case Variant::type::int_t: return m_arena->create<Int>(value_str);
+	case Variant::type::vector_t: return m_arena->create<VectorVariant>(m_arena, m_key_pool);
+	case Variant::type::map_t: return m_arena->create<MapVariant>(m_arena, m_key_pool);
+	default: return m_arena->create<Null>();
+	}
+}
+
+Variant* ContainerVariant::_create_number(const ParsedNumber& number)
+{
+	const bool is_float = number.m_type == Enums::e_number::DOUBLE;
+	if(m_arena == nullptr)
+		return is_float ? static_cast<Variant*>(new Float(number)) : new Int(number);
+	return is_float ? static_cast<Variant*>(m_arena->create<Float>(number)) : m_arena->create<Int>(number);
+}
+
+VectorVariant::~VectorVariant()
+{
+	if(m_arena == nullptr)
+	{
+		for(Variant* variant : m_container)
+			delete variant;
 	}
 }
 
+void VectorVariant::add_variant(Variant::type var_type, StringRef value_str, StringRef key, bool escaped)
+{
+	m_container.push_back(_create_variant(var_type, value_str, escaped));
+}
+
+void VectorVariant::add_number(const ParsedNumber& number, StringRef key, bool escaped)
+{
+	m_container.push_back(_create_number(number));
+}
+
 Variant* VectorVariant::get_last_added_variant()
 {
 	Variant* result = nullptr;
 
 	if(m_container.size() > 0)
 	{
-		result = m_container[m_container.size() - 1].get();
+		result = m_container[m_container.size() - 1];
 	}
 
 	return result;
 }
 
-void MapVariant::add_variant(Variant::type var_type, std::string& value_str, std::string key)
+MapVariant::~MapVariant()
 {
-	switch(var_type)
+	if(m_arena == nullptr)
 	{
-	case Variant::type::null_t:
-		m_container[key] = std::make_unique<Null>();
-		break;
-	case Variant::type::string_t:
-		m_container[key] = std::make_unique<StringV>(value_str);
-		break;
-	case Variant::type::bool_t:
-		m_container[key] = std::make_unique<Bool>(value_str);
-		break;
-	case Variant::type::float_t:
-		m_container[key] = std::make_unique<Float>(value_str);
-		break;
-	case Variant::type::int_t:
-		m_container[key] = std::make_unique<Int>(value_str);
-		break;
-	case Variant::type::vector_t:
-		m_container[key] = std::make_unique<VectorVariant>();
-		break;
-	case Variant::type::map_t:
-		m_container[key] = std::make_unique<MapVariant>();
-		break;
+		for(auto& pair : m_container)
+			delete pair.second;
 	}
-	m_last_added_key = key;
+}
+
+void MapVariant::add_variant(Variant::type var_type, StringRef value_str, StringRef key, bool escaped)
+{
+	_get_key_pool(); //first, so child containers share the pool
+	_add_member(key, escaped, _create_variant(var_type, value_str, escaped));
+}
+
+void MapVariant::add_number(const ParsedNumber& number, StringRef key, bool escaped)
+{
+	_add_member(key, escaped, _create_number(number));
+}
+
+void MapVariant::_add_member(StringRef key, bool escaped, Variant* variant)
+{
+	const InternedKey* interned = _get_key_pool()->intern(key, escaped);
+	auto result = m_container.emplace(interned, variant);
+	if(!result.second) //duplicate key, the last value wins
+	{
+		if(m_arena == nullptr)
+			delete result.first->second;
+		result.first->second = variant;
+	}
+	m_last_added = variant;
 }
 
 Variant* MapVariant::get_last_added_variant()
 {
-	Variant* result = nullptr;
-	if(m_container.size() > 0)
+	return m_last_added;
+}
+
+KeyPool* MapVariant::_get_key_pool()
+{
+	if(m_key_pool == nullptr)
 	{
-		result = m_container[m_last_added_key].get();
+		if(m_arena != nullptr)
+		{
+			m_key_pool = m_arena->create<KeyPool>(m_arena);
+		}
+		else
+		{
+			m_own_key_pool.reset(new KeyPool());
+			m_key_pool = m_own_key_pool.get();
+		}
 	}
-	return result;
+	return m_key_pool;
 }
 
 void MapVariant::print_keys() const
@@ -115,7 +158,7 @@ void MapVariant::print_keys() const
 	int i = 0;
 	for(auto& pair : m_container)
 	{
-		std::cout << i << ")" << pair.first << "\n";
+		std::cout << i << ")" << pair.first->get_string().to_string() << "\n";
 		i++;
 	}
 }
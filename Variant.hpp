@@ -31,12 +31,22 @@
  */
 #pragma once
 #include <string>
+#include <cfloat>
+#include <cmath>
 #include <iostream>
 #include <vector>
 #include <unordered_map>
 #include <memory>
 
-typedef  std::string string_data;
+#include "StringRef.hpp"
+#include "Arena.hpp"
+#include "NumberParser.hpp"
+#include "KeyPool.hpp"
+#include "FlatKeyMap.hpp"
+
+//Strings held by parsed variants live in the document's Arena.  Copying one (or converting a StringV to
+//std::string) gives an ordinary heap allocated string that outlives the document.
+typedef  std::basic_string<char, std::char_traits<char>, MJSON::ArenaAllocator<char>> string_data;
 
 namespace MJSON
 {
@@ -49,6 +59,10 @@ namespace MJSON
 			m_type(var_type)
 		{}
 
+		Variant(type var_type, Arena* arena):
+			m_type(var_type), m_string(string_data::allocator_type(arena))
+		{}
+
 		virtual ~Variant()
 		{
 			//std::cout << "MSJON::Variant::~Variant()\n";
@@ -58,18 +72,28 @@ namespace MJSON
 
 		type m_type;
 
+		//Int and Float keep a full precision value alongside the int or float view, Bool uses m_bool.
+		//The views share the four bytes after m_type that alignment leaves free.
 		union {
 			int m_signed_int;
-			//unsigned int m_unsigned_int;
 			bool m_bool;
 			float m_float;
+			bool m_escaped; //StringV, m_string still holds the source's escape sequences
+		};
+		union {
+			int64_t m_int64;
+			uint64_t m_uint64;
+			double m_double;
 		};
 		string_data m_string;
 
 	};
 
-	using VariantVec_t = std::vector<std::unique_ptr<Variant>> ;
-	using VariantMap_t = std::unordered_map<std::string, std::unique_ptr<Variant>> ;
+	//Containers do not own their children through the container types.  In a parsed document every Variant is
+	//owned by the document's Arena, otherwise the container deletes its children when destroyed.  Map keys are
+	//handles into the document's KeyPool, which hashed them once when interned, and members keep document order.
+	using VariantVec_t = std::vector<Variant*, ArenaAllocator<Variant*>> ;
+	using VariantMap_t = FlatKeyMap<Variant*>;
 
 	class Null: public Variant
 	{
@@ -91,24 +115,34 @@ namespace MJSON
 
 		Int():Variant(type::int_t)
 		{
-			m_signed_int = 0;
+			set_int64(0);
 		}
 
 		Int(const Int & i):Int()
 		{
-			m_signed_int = i.m_signed_int;
+			*this = i;
 		}
 
 		Int(int i):Int()
 		{
-			m_signed_int = i;
+			set_int64(i);
 		}
 
 		Int(string_data& s):Int()
+		{
+			_from_string(StringRef(s));
+		}
+
+		Int(StringRef s):Int()
 		{
 			_from_string(s);
 		}
 
+		explicit Int(const ParsedNumber& number):Int()
+		{
+			_from_number(number);
+		}
+
 		virtual ~Int(){};
 
 		int to_type()
@@ -116,52 +150,74 @@ namespace MJSON
 			return m_signed_int;
 		}
 
+		//m_signed_int is clamped to the range of int, the full value is available from these
+		int64_t get_int64() const {return is_unsigned() ? INT64_MAX : m_int64;}
+		uint64_t get_uint64() const {return m_uint64;}
+		bool is_unsigned() const {return m_int64 < 0 && m_signed_int == INT32_MAX;} //true when the value is above INT64_MAX, no flag is stored
+
+		void set_int64(int64_t i)
+		{
+			m_int64 = i;
+			m_signed_int = i > INT32_MAX ? INT32_MAX : (i < INT32_MIN ? INT32_MIN : (int)i);
+		}
+
+		void set_uint64(uint64_t ui)
+		{
+			if(ui <= (uint64_t)INT64_MAX)
+			{
+				set_int64((int64_t)ui);
+				return;
+			}
+			m_uint64 = ui;
+			m_signed_int = INT32_MAX;
+		}
+
 		void operator=(const int& i)
 		{
-			m_signed_int = i;
+			set_int64(i);
 		}
 
 		void operator=(const Int & i)
 		{
+			m_int64 = i.m_int64;
 			m_signed_int = i.m_signed_int;
 		}
 
 		void operator=(const unsigned int & ui)
 		{
-			m_signed_int = (int)ui;
+			set_int64(ui);
 		}
 
 		void operator=(const bool & b)
 		{
-			m_signed_int = (int)b;
+			set_int64(b);
 		}
 
 		void operator=(const float & f)
 		{
-			m_signed_int = (int) f;
+			set_int64((int64_t) f);
 		}
 
 		void operator=(const string_data & s)
 		{
-			_from_string(s);
+			_from_string(StringRef(s));
 		}
 
 		operator int() const { return m_signed_int;}
 
 	private:
 
-		void _from_string(const string_data & s)
+		void _from_string(StringRef s)
 		{
-			int num = 0;
-			try
-			{
-				num = std::stoi(s);
-			}
-			catch (const std::invalid_argument& exception)
-			{
-				std::cerr << "Invalid args, number must be present at the beginning of the string.\n";
-			}
-			m_signed_int = (int)num;
+			_from_number(NumberParser::parse(s));
+		}
+
+		void _from_number(const ParsedNumber& number)
+		{
+			if(number.m_type == Enums::e_number::UINT64)
+				set_uint64(number.m_uint64);
+			else
+				set_int64(number.to_int64());
 		}
 	};
 
@@ -172,77 +228,89 @@ namespace MJSON
 	public:
 		Float():Variant(type::float_t)
 		{
-			m_float = 0.0f;
+			set_double(0.0);
 		}
 
 		virtual ~Float(){};
 
 		Float(const Float& f): Float()
 		{
-			m_float = f.m_float;
+			*this = f;
 		}
 
 		Float(float f) : Float()
 		{
-			m_float = f;
+			set_double(f);
 		}
 
 		Float(int i) : Float()
 		{
-			m_float = (float)i;
+			set_double(i);
 		}
 
 		Float(const string_data & s) : Float()
+		{
+			_from_string(StringRef(s));
+		}
+
+		Float(StringRef s) : Float()
 		{
 			_from_string(s);
 		}
 
+		explicit Float(const ParsedNumber& number) : Float()
+		{
+			set_double(number.to_double());
+		}
+
 		float to_type()
 		{
 			return m_float;
 		}
 
+		double get_double() const {return m_double;} //m_float is rounded to float precision
+
+		void set_double(double d)
+		{
+			m_double = d;
+			if(d > FLT_MAX || d < -FLT_MAX) //out of range conversions are undefined
+				m_float = d > 0.0 ? HUGE_VALF : -HUGE_VALF;
+			else
+				m_float = (float)d;
+		}
+
 		void operator=(const float& f)
 		{
-			m_float = f;
+			set_double(f);
 		}
 
 		void operator=(const Float& f)
 		{
-			m_float = f.m_float;
+			set_double(f.m_double);
 		}
 
 		void operator=(const int& i)
 		{
-			m_float = (float) i;
+			set_double(i);
 		}
 
 		void operator=(const Int& i)
 		{
-			m_float = (float)i.m_signed_int;
+			set_double(i.is_unsigned() ? (double)i.get_uint64() : (double)i.get_int64());
 		}
 
 		void operator=(const string_data & s)
 		{
-			_from_string(s);
+			_from_string(StringRef(s));
 		}
 
 		operator float() const {return m_float;}
 
 	private:
 
-		void _from_string(const string_data & s)
+		void _from_string(StringRef s)
 		{
-			float num = 0;
-			try
-			{
-				num = std::stof(s);
-			}
-			catch (const std::invalid_argument& exception)
-			{
-				std::cerr << "Invalid args, number must be present at the beginning of the string.\n";
-			}
-			m_float = (float)num;
+			set_double(NumberParser::parse(s).to_double());
 		}
 
 	};
@@ -267,7 +335,10 @@ namespace MJSON
 			m_bool = b;
 		}
 
-		Bool(const std::string&s):Bool()
+		Bool(const std::string&s):Bool(StringRef(s))
+		{}
+
+		Bool(StringRef s):Bool()
 		{
 			if(s == "true" || s == "True" || s == "TRUE")
 				m_bool = true;
@@ -289,12 +360,14 @@ namespace MJSON
 		StringV():Variant(type::string_t)
 		{
 			m_string = "";
+			m_escaped = false;
 		};
 		virtual ~StringV() {};
 
 		StringV(const StringV&s) : StringV()
 		{
 			m_string = s.m_string;
+			m_escaped = s.m_escaped;
 		}
 
 		StringV(const string_data& s):StringV()
@@ -307,30 +380,43 @@ namespace MJSON
 			m_string = string_data(s);
 		}
 
+		StringV(StringRef s): StringV()
+		{
+			m_string.assign(s.data(), s.size());
+		}
+
+		StringV(StringRef s, Arena* arena, bool escaped = false): Variant(type::string_t, arena)
+		{
+			m_string.assign(s.data(), s.size());
+			m_escaped = escaped;
+		}
+
 		void operator=(const StringV& s)
 		{
 			m_string = s.m_string;
+			m_escaped = s.m_escaped;
 		}
 
 		void operator=(const string_data& s)
 		{
 			m_string = s;
+			m_escaped = false;
 		}
 
 		void operator=(const char* s)
 		{
 			m_string = string_data(s);
+			m_escaped = false;
 		}
 
 		bool operator==(const char* s)
 		{
-			std::string other(s);
-			return m_string == other;
+			return m_string == s;
 		}
 
 		bool operator==(const std::string& other)
 		{
-			return m_string == other;
+			return StringRef(m_string) == StringRef(other);
 		}
 
 		bool operator==(const StringV& other)
@@ -338,45 +424,97 @@ namespace MJSON
 			return m_string == other.m_string;
 		}
 
-		operator std::string() const {return m_string;}
+		operator std::string() const {return std::string(m_string.data(), m_string.size());}
 		operator const char*() const {return m_string.c_str();}
 	};
 
+	class VectorVariant;
+	class MapVariant;
+
+	//Casts to a concrete Variant type by checking m_type, giving nullptr if the variant is null or another type.
+	//Other targets, such as ContainerVariant, fall back to dynamic_cast.
+	template<typename T>
+	T* variant_cast(Variant* variant)
+	{
+		return dynamic_cast<T*>(variant);
+	}
+
+	template<typename T>
+	const T* variant_cast(const Variant* variant)
+	{
+		return variant_cast<T>(const_cast<Variant*>(variant));
+	}
+
+	template<> inline Null* variant_cast<Null>(Variant* v) {return v != nullptr && v->m_type == Variant::type::null_t ? static_cast<Null*>(v) : nullptr;}
+	template<> inline Int* variant_cast<Int>(Variant* v) {return v != nullptr && v->m_type == Variant::type::int_t ? static_cast<Int*>(v) : nullptr;}
+	template<> inline Float* variant_cast<Float>(Variant* v) {return v != nullptr && v->m_type == Variant::type::float_t ? static_cast<Float*>(v) : nullptr;}
+	template<> inline Bool* variant_cast<Bool>(Variant* v) {return v != nullptr && v->m_type == Variant::type::bool_t ? static_cast<Bool*>(v) : nullptr;}
+	template<> inline StringV* variant_cast<StringV>(Variant* v) {return v != nullptr && v->m_type == Variant::type::string_t ? static_cast<StringV*>(v) : nullptr;}
+	template<> VectorVariant* variant_cast<VectorVariant>(Variant* v);
+	template<> MapVariant* variant_cast<MapVariant>(Variant* v);
+
 	class ContainerVariant : public Variant
 	{
 	public:
 
-		ContainerVariant(type container_type): Variant(container_type)		{}
+		ContainerVariant(type container_type, Arena* arena, KeyPool* key_pool):
+			Variant(container_type, arena), m_arena(arena), m_key_pool(key_pool)
+		{}
 		virtual ~ContainerVariant(){};
 
-		virtual void add_variant(Variant::type var_type, std::string& value_str, std::string key = "") = 0;
+		//Strings and keys are written back out escaped.  Parsers pass escaped as true, their strings and keys
+		//are source text with the escape sequences still in place, so are written back unchanged.
+		virtual void add_variant(Variant::type var_type, StringRef value_str, StringRef key = StringRef(), bool escaped = false) = 0;
+		virtual void add_number(const ParsedNumber& number, StringRef key = StringRef(), bool escaped = false) = 0; //Float for DOUBLE, otherwise Int
 		virtual Variant* get_last_added_variant() = 0;
-	};
 
-	class MapVariant;
+		Arena* get_arena() const {return m_arena;}
+		KeyPool* get_key_pool() const {return m_key_pool;}
+
+	protected:
+		Variant* _create_variant(Variant::type var_type, StringRef value_str, bool escaped); //allocated from m_arena, or the heap if there is none
+		Variant* _create_number(const ParsedNumber& number);
+
+		Arena* m_arena;
+		KeyPool* m_key_pool; //shared by every container in a document, child containers inherit it
+	};
 
 	class VectorVariant : public ContainerVariant
 	{
 	public:
-		VectorVariant():ContainerVariant(type::vector_t)
+		VectorVariant(Arena* arena = nullptr, KeyPool* key_pool = nullptr):ContainerVariant(type::vector_t, arena, key_pool),
+			m_container(VariantVec_t::allocator_type(arena))
 		{
 
 		}
-		virtual ~VectorVariant(){};
+		virtual ~VectorVariant();
 
-		void add_variant(Variant::type var_type, std::string& value_str, std::string key = "") override;
+		void add_variant(Variant::type var_type, StringRef value_str, StringRef key = StringRef(), bool escaped = false) override;
+		void add_number(const ParsedNumber& number, StringRef key = StringRef(), bool escaped = false) override;
 		Variant* get_last_added_variant() override;
 
 		template<typename T>
 		T* get_value(const int& idx)
 		{
-			return dynamic_cast<T*>(m_container[idx].get());
+			return variant_cast<T>(m_container[idx]);
 		}
 
 		template<typename T>
 		T& get_ref_to_value(const int& idx)
 		{
-			return *dynamic_cast<T*>(m_container[idx].get());
+			return *variant_cast<T>(m_container[idx]);
+		}
+
+		//Bounds checked, nullptr when idx is out of range or the element is not a T
+		Variant* find(int idx) const
+		{
+			return idx >= 0 && idx < size() ? m_container[idx] : nullptr;
+		}
+
+		template<typename T>
+		T* get(int idx) const
+		{
+			return variant_cast<T>(find(idx));
 		}
 
 		int size() const
@@ -386,12 +524,12 @@ namespace MJSON
 
 		Variant* operator[](const int& idx)
 		{
-			return m_container[idx].get();
+			return m_container[idx];
 		}
 
 		Variant* operator[](const Int& idx)
 		{
-			return m_container[idx.m_signed_int].get();
+			return m_container[idx.m_signed_int];
 		}
 
 		VariantVec_t m_container;
@@ -401,35 +539,61 @@ namespace MJSON
 	class MapVariant : public ContainerVariant
 	{
 	public:
-		MapVariant():ContainerVariant(type::map_t)
+		MapVariant(Arena* arena = nullptr, KeyPool* key_pool = nullptr):ContainerVariant(type::map_t, arena, key_pool),
+			m_container(arena)
 		{}
-		virtual ~MapVariant(){};
+		virtual ~MapVariant();
 
-		void add_variant(Variant::type var_type, std::string& value_str, std::string key = "") override;
+		void add_variant(Variant::type var_type, StringRef value_str, StringRef key = StringRef(), bool escaped = false) override;
+		void add_number(const ParsedNumber& number, StringRef key = StringRef(), bool escaped = false) override;
 		Variant* get_last_added_variant() override;
 
+		//Lookups never insert or allocate, a missing key gives nullptr.  StringRef converts from string
+		//literals, const char* and std::string without copying.
+		Variant* find(StringRef key) const
+		{
+			return find(key, key.hash());
+		}
+
+		Variant* find(StringRef key, std::size_t hash) const //hash must be key.hash(), for callers that hash keys ahead of time
+		{
+			const InternedKey* interned = m_key_pool != nullptr ? m_key_pool->find(key, hash) : nullptr; //a key never interned can't be present
+			return interned != nullptr ? find(interned) : nullptr;
+		}
+
+		Variant* find(const InternedKey* key) const
+		{
+			auto it = m_container.find(key);
+			return it != m_container.end() ? it->second : nullptr;
+		}
+
+		Variant* find(const StaticKey& key) const
+		{
+			return find(key.get_string(), key.hash());
+		}
+
 		template<typename T>
-		T* get_value(const char* key)
+		T* get(StringRef key) const //nullptr when missing or not a T
 		{
-			return dynamic_cast<T*>(m_container[key].get());
+			return variant_cast<T>(find(key));
 		}
 
 		template<typename T>
-		T* get_value(const std::string& key)
+		T* get(const StaticKey& key) const
 		{
-			return get_value<T>(key.c_str());
+			return variant_cast<T>(find(key));
 		}
 
 		template<typename T>
-		T& get_ref_to_value(const std::string& key)
+		T* get_value(StringRef key)
 		{
-			return *get_value<T>(key.c_str());
+			return get<T>(key);
 		}
 
 		template<typename T>
-		T& get_ref_to_value(const char* key)
+		T& get_ref_to_value(StringRef key)
 		{
-			return *get_value<T>(key);
+			return *get<T>(key);
 		}
 
 		int size() const
@@ -437,35 +601,43 @@ namespace MJSON
 			return m_container.size();
 		}
 
-		bool has(const char* key) const
+		bool has(StringRef key) const
 		{
-			return m_container.find(key) != m_container.end();
+			return find(key) != nullptr;
 		}
 
-		bool has(const std::string& key) const
+		bool has(const StaticKey& key) const
 		{
-			return has(key.c_str());
+			return find(key) != nullptr;
 		}
 
 		void print_keys() const;
 
 		Variant* operator[](const std::string& key)
 		{
-			return m_container[key].get();
+			return find(key);
 		}
 
 		Variant* operator[](const char* key)
 		{
-			return m_container[key].get();
+			return find(key);
 		}
 
 		Variant* operator[](const StringV& key)
 		{
-			return m_container[key.m_string].get();
+			return find(key.m_string);
 		}
 
 		VariantMap_t m_container;
-		std::string m_last_added_key = "";
+
+	private:
+		KeyPool* _get_key_pool(); //creates a pool for maps built outside of a parsed document
+		void _add_member(StringRef key, bool escaped, Variant* variant);
+
+		Variant* m_last_added = nullptr;
+		std::unique_ptr<KeyPool> m_own_key_pool;
 	};
 
+	template<> inline VectorVariant* variant_cast<VectorVariant>(Variant* v) {return v != nullptr && v->m_type == Variant::type::vector_t ? static_cast<VectorVariant*>(v) : nullptr;}
+	template<> inline MapVariant* variant_cast<MapVariant>(Variant* v) {return v != nullptr && v->m_type == Variant::type::map_t ? static_cast<MapVariant*>(v) : nullptr;}
 }
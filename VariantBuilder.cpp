@@ -0,0 +1,96 @@
+/*
+ * VariantBuilder.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "VariantBuilder.hpp"
+
+#include <cassert>
+
+using namespace MJSON;
+
+void VariantBuilder::begin(Arena& arena, KeyPool* key_pool)
+{
+	m_arena = &arena;
+	m_key_pool = key_pool;
+	m_stack.clear();
+	m_root = nullptr;
+	m_has_key = false;
+}
+
+void VariantBuilder::open_container(Variant::type container_type)
+{
+	if(m_stack.empty())
+	{
+		assert(m_root == nullptr && "Root container already set, something's gone wrong\n");
+		if(m_key_pool == nullptr) //one per document, shared by all of its maps
+			m_key_pool = m_arena->create<KeyPool>(m_arena);
+		if(container_type == Variant::type::map_t)
+			m_root = m_arena->create<MapVariant>(m_arena, m_key_pool);
+		else
+			m_root = m_arena->create<VectorVariant>(m_arena, m_key_pool);
+		m_stack.push_back(m_root);
+		return;
+	}
+
+	add_value(container_type, StringRef());
+	m_stack.push_back(static_cast<ContainerVariant*>(m_stack.back()->get_last_added_variant()));
+}
+
+void VariantBuilder::close_container(Variant::type container_type)
+{
+	assert(!m_stack.empty() && m_stack.back()->m_type == container_type && !m_has_key && "Invalid token sequence, unexpected end of container.\n");
+	(void)container_type;
+	m_stack.pop_back();
+}
+
+void VariantBuilder::set_key(StringRef key)
+{
+	assert(expects_key() && "Invalid token sequence, object key can't follow another key\n");
+	m_key = key;
+	m_has_key = true;
+}
+
+void VariantBuilder::add_value(Variant::type var_type, StringRef value)
+{
+	StringRef key = _take_key();
+	m_stack.back()->add_variant(var_type, value, key, true);
+}
+
+void VariantBuilder::add_number(const ParsedNumber& number)
+{
+	StringRef key = _take_key();
+	m_stack.back()->add_number(number, key, true);
+}
+
+StringRef VariantBuilder::_take_key()
+{
+	assert(!m_stack.empty() && "Root object container not set. Object or Array must be root.\n");
+	if(m_stack.back()->m_type != Variant::type::map_t)
+		return StringRef();
+	assert(m_has_key && "Invalid token sequence, object value without a key.\n");
+	m_has_key = false;
+	return m_key;
+}
@@ -0,0 +1,66 @@
+/*
+ * VariantBuilder.hpp
+ * Assembles a Variant tree from values handed to it in document order.  Shared by the parsers that
+ * work directly from the source (SinglePassParser, PushParser) so they only deal with scanning.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <vector>
+
+#include "Arena.hpp"
+#include "StringRef.hpp"
+#include "Variant.hpp"
+
+namespace MJSON
+{
+	class VariantBuilder
+	{
+	public:
+		void begin(Arena& arena, KeyPool* key_pool = nullptr); //starts a new tree allocated from arena, with a new key pool unless given one
+
+		void open_container(Variant::type container_type);
+		void close_container(Variant::type container_type);
+
+		bool in_object() const {return !m_stack.empty() && m_stack.back()->m_type == Variant::type::map_t;}
+		bool expects_key() const {return !m_stack.empty() && m_stack.back()->m_type == Variant::type::map_t && !m_has_key;}
+		void set_key(StringRef key); //key must remain valid until its value has been added
+		void add_value(Variant::type var_type, StringRef value); //value and key are source text, escape sequences included
+		void add_number(const ParsedNumber& number); //number already parsed, so its text is only scanned once
+
+		ContainerVariant* get_root() const {return m_root;}
+		bool is_complete() const {return m_root != nullptr && m_stack.empty();}
+
+	private:
+		StringRef _take_key(); //key for the next value, empty within an array
+
+		Arena* m_arena = nullptr;
+		KeyPool* m_key_pool = nullptr;
+		std::vector<ContainerVariant*> m_stack; //explicit stack of open containers, reused between documents
+		ContainerVariant* m_root = nullptr;
+		StringRef m_key; //key waiting for its value, only valid while m_has_key is set
+		bool m_has_key = false;
+	};
+}
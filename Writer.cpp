@@ -0,0 +1,482 @@
+/*
+ * Writer.cpp
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#include "Writer.hpp"
+#include "NumberParser.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MJSON_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+using namespace MJSON;
+
+namespace
+{
+	const char c_DIGIT_PAIRS[] =
+		"0001020304050607080910111213141516171819"
+		"2021222324252627282930313233343536373839"
+		"4041424344454647484950515253545556575859"
+		"6061626364656667686970717273747576777879"
+		"8081828384858687888990919293949596979899";
+
+	inline bool needs_escape(char c)
+	{
+		return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+	}
+
+#ifdef MJSON_SSE2
+	inline int trailing_zeros(uint32_t bits)
+	{
+#if defined(_MSC_VER)
+		unsigned long idx;
+		_BitScanForward(&idx, bits);
+		return (int)idx;
+#else
+		return __builtin_ctz(bits);
+#endif
+	}
+#endif
+
+	//Returns the first character that must be escaped, checking 16 characters at a time where SSE2 is available
+	const char* find_escape(const char* cursor, const char* end)
+	{
+#ifdef MJSON_SSE2
+		const __m128i quote = _mm_set1_epi8('"');
+		const __m128i backslash = _mm_set1_epi8('\\');
+		const __m128i control_max = _mm_set1_epi8(0x1F);
+		while(end - cursor >= 16)
+		{
+			__m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+			__m128i is_control = _mm_cmpeq_epi8(_mm_max_epu8(chars, control_max), control_max); //unsigned chars <= 0x1F
+			__m128i mask = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, quote), _mm_cmpeq_epi8(chars, backslash)), is_control);
+			uint32_t bits = (uint32_t)_mm_movemask_epi8(mask);
+			if(bits != 0)
+				return cursor + trailing_zeros(bits);
+			cursor += 16;
+		}
+#endif
+		while(cursor < end && !needs_escape(*cursor))
+			cursor++;
+		return cursor;
+	}
+
+	const double c_POWERS_OF_TEN[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+	//Writes the digits of value ending at last, returning the first digit
+	char* format_uint(uint64_t value, char* last)
+	{
+		while(value >= 100)
+		{
+			last -= 2;
+			std::memcpy(last, c_DIGIT_PAIRS + (value % 100) * 2, 2);
+			value /= 100;
+		}
+		if(value >= 10)
+		{
+			last -= 2;
+			std::memcpy(last, c_DIGIT_PAIRS + value * 2, 2);
+		}
+		else
+		{
+			*--last = (char)('0' + value);
+		}
+		return last;
+	}
+
+	//How far the decimal found may be from value and still read back as it.  Doubles must match exactly, for
+	//floats the decimal is rounded to double then float, so must be well within half a float step.
+	inline double read_back_tolerance(double)
+	{
+		return 0.0;
+	}
+
+	inline double read_back_tolerance(float value)
+	{
+		double below = value - std::nextafter(value, 0.0f);
+		double above = std::nextafter(value, 2.0f * value) - value;
+		return std::min(below, above) * 0.4999;
+	}
+
+	//Most values written have few decimal places, so are found as n / 10^k without snprintf
+	template<typename T>
+	int format_fixed(char* out, T value, int max_decimals)
+	{
+		double magnitude = std::fabs((double)value);
+		double tolerance = read_back_tolerance(value);
+		for(int decimals = 0; decimals <= max_decimals; decimals++)
+		{
+			double scaled = magnitude * c_POWERS_OF_TEN[decimals];
+			if(scaled >= 9007199254740992.0) //2^53, beyond which n is not exact
+				return 0;
+			double n = std::floor(scaled + 0.5);
+			if(std::fabs(n / c_POWERS_OF_TEN[decimals] - magnitude) > tolerance)
+				continue;
+
+			char digits[24];
+			char* end = digits + sizeof(digits);
+			char* first = format_uint((uint64_t)n, end);
+			while(end - first <= decimals) //leading zeros of a fraction
+				*--first = '0';
+
+			int length = 0;
+			if(std::signbit(value)) //including -0.0
+				out[length++] = '-';
+			std::size_t whole = (end - first) - decimals;
+			std::memcpy(out + length, first, whole);
+			length += (int)whole;
+			out[length++] = '.';
+			if(decimals == 0)
+			{
+				out[length++] = '0';
+			}
+			else
+			{
+				std::memcpy(out + length, first + whole, decimals);
+				length += decimals;
+			}
+			return length;
+		}
+		return 0;
+	}
+
+	//snprintf writes the LC_NUMERIC decimal point, which JSON requires to be '.'
+	int use_decimal_point(char* out, int length)
+	{
+		const char* point = std::localeconv()->decimal_point;
+		if(point[0] == '.' && point[1] == '\0')
+			return length;
+		char* found = std::strstr(out, point);
+		if(found == nullptr)
+			return length;
+		std::size_t point_length = std::strlen(point);
+		*found = '.';
+		std::memmove(found + 1, found + point_length, out + length + 1 - (found + point_length)); //includes the terminator
+		return length - (int)(point_length - 1);
+	}
+
+	//Formats with the fewest significant digits that read back as the same value
+	template<typename T>
+	int format_shortest(char* out, std::size_t out_size, T value, int min_precision, int max_precision)
+	{
+		int length = format_fixed(out, value, std::min(max_precision, 15));
+		if(length > 0)
+			return length;
+
+		for(int precision = min_precision; precision <= max_precision; precision++)
+		{
+			length = use_decimal_point(out, std::snprintf(out, out_size, "%.*g", precision, (double)value));
+			if((T)NumberParser::strtod_c_locale(out) == value)
+				break;
+		}
+		if(std::strpbrk(out, ".eE") == nullptr) //keep it a float when read back
+		{
+			out[length++] = '.';
+			out[length++] = '0';
+			out[length] = '\0';
+		}
+		return length;
+	}
+}
+
+void Writer::set_pretty(bool pretty, int indent_width)
+{
+	m_pretty = pretty;
+	m_indent_width = indent_width;
+}
+
+void Writer::clear()
+{
+	m_size = 0;
+	m_has_values.clear();
+	m_after_key = false;
+}
+
+void Writer::start_object()
+{
+	_before_value();
+	_put('{');
+	m_has_values.push_back(0);
+}
+
+void Writer::end_object()
+{
+	_end_container('}');
+}
+
+void Writer::start_array()
+{
+	_before_value();
+	_put('[');
+	m_has_values.push_back(0);
+}
+
+void Writer::end_array()
+{
+	_end_container(']');
+}
+
+void Writer::write_key(StringRef key)
+{
+	_before_value();
+	_write_escaped(key);
+	_append(": ", m_pretty ? 2 : 1);
+	m_after_key = true;
+}
+
+void Writer::write_string(StringRef s)
+{
+	_before_value();
+	_write_escaped(s);
+}
+
+void Writer::write_int(int64_t i)
+{
+	_before_value();
+
+	char digits[20];
+	char* first = format_uint(i < 0 ? 0 - (uint64_t)i : (uint64_t)i, digits + sizeof(digits));
+	std::size_t length = digits + sizeof(digits) - first;
+	char* out = _reserve(length + 1);
+	if(i < 0)
+		*out++ = '-';
+	std::memcpy(out, first, length);
+	m_size += length + (i < 0 ? 1 : 0);
+}
+
+void Writer::write_uint(uint64_t ui)
+{
+	_before_value();
+
+	char digits[20];
+	char* first = format_uint(ui, digits + sizeof(digits));
+	_append(first, digits + sizeof(digits) - first);
+}
+
+void Writer::write_float(float f)
+{
+	if(!std::isfinite(f))
+	{
+		write_null(); //JSON has no representation for infinity or NaN
+		return;
+	}
+	_before_value();
+	char out[32];
+	_append(out, format_shortest(out, sizeof(out), f, 6, 9));
+}
+
+void Writer::write_double(double d)
+{
+	if(!std::isfinite(d))
+	{
+		write_null();
+		return;
+	}
+	_before_value();
+	char out[40];
+	_append(out, format_shortest(out, sizeof(out), d, 15, 17));
+}
+
+void Writer::write_bool(bool b)
+{
+	_before_value();
+	if(b)
+		_append("true", 4);
+	else
+		_append("false", 5);
+}
+
+void Writer::write_null()
+{
+	_before_value();
+	_append("null", 4);
+}
+
+void Writer::write(const Variant& variant)
+{
+	switch(variant.m_type)
+	{
+	case Variant::type::int_t:
+		if(static_cast<const Int&>(variant).is_unsigned())
+			write_uint(variant.m_uint64);
+		else
+			write_int(variant.m_int64);
+		break;
+	case Variant::type::float_t:
+		write_double(variant.m_double); //a parsed Float always holds the full double
+		break;
+	case Variant::type::bool_t:
+		write_bool(variant.m_bool);
+		break;
+	case Variant::type::string_t:
+		if(variant.m_escaped)
+		{
+			_before_value();
+			_write_quoted_raw(variant.m_string);
+		}
+		else
+		{
+			write_string(variant.m_string);
+		}
+		break;
+	case Variant::type::vector_t:
+		start_array();
+		for(const Variant* element : static_cast<const VectorVariant&>(variant).m_container)
+			write(*element);
+		end_array();
+		break;
+	case Variant::type::map_t:
+		start_object();
+		for(const auto& member : static_cast<const MapVariant&>(variant).m_container)
+		{
+			if(member.first->m_escaped)
+				_write_key_raw(member.first->get_string());
+			else
+				write_key(member.first->get_string());
+			write(*member.second);
+		}
+		end_object();
+		break;
+	default:
+		write_null();
+		break;
+	}
+}
+
+void Writer::_before_value()
+{
+	if(m_after_key)
+	{
+		m_after_key = false;
+		return;
+	}
+	if(m_has_values.empty())
+		return;
+
+	if(m_has_values.back())
+		_put(',');
+	m_has_values.back() = 1;
+	if(m_pretty)
+		_new_line();
+}
+
+void Writer::_end_container(char c)
+{
+	assert(!m_has_values.empty() && !m_after_key && "Container ended without being started, or a key has no value\n");
+	bool has_values = m_has_values.back() != 0;
+	m_has_values.pop_back();
+	if(m_pretty && has_values)
+		_new_line();
+	_put(c);
+}
+
+void Writer::_new_line()
+{
+	std::size_t indent = m_has_values.size() * m_indent_width;
+	char* out = _reserve(indent + 1);
+	out[0] = '\n';
+	std::memset(out + 1, ' ', indent);
+	m_size += indent + 1;
+}
+
+void Writer::_write_escaped(StringRef s)
+{
+	_put('"');
+	const char* cursor = s.begin();
+	const char* end = s.end();
+	while(true)
+	{
+		const char* escape = find_escape(cursor, end);
+		_append(cursor, escape - cursor);
+		if(escape == end)
+			break;
+
+		switch(*escape)
+		{
+		case '"': _append("\\\"", 2); break;
+		case '\\': _append("\\\\", 2); break;
+		case '\b': _append("\\b", 2); break;
+		case '\f': _append("\\f", 2); break;
+		case '\n': _append("\\n", 2); break;
+		case '\r': _append("\\r", 2); break;
+		case '\t': _append("\\t", 2); break;
+		default:
+			{
+				char unicode[7];
+				std::snprintf(unicode, sizeof(unicode), "\\u%04x", (unsigned)(unsigned char)*escape);
+				_append(unicode, 6);
+				break;
+			}
+		}
+		cursor = escape + 1;
+	}
+	_put('"');
+}
+
+void Writer::_write_quoted_raw(StringRef s)
+{
+	char* out = _reserve(s.size() + 2);
+	out[0] = '"';
+	if(!s.empty())
+		std::memcpy(out + 1, s.data(), s.size());
+	out[s.size() + 1] = '"';
+	m_size += s.size() + 2;
+}
+
+void Writer::_write_key_raw(StringRef key)
+{
+	_before_value();
+	_write_quoted_raw(key);
+	_append(": ", m_pretty ? 2 : 1);
+	m_after_key = true;
+}
+
+char* Writer::_reserve(std::size_t length)
+{
+	if(m_size + length > m_buffer.size())
+		m_buffer.resize(std::max(std::max(m_buffer.size() * 2, m_size + length), (std::size_t)256));
+	return &m_buffer[m_size];
+}
+
+void Writer::_append(const char* s, std::size_t length)
+{
+	if(length == 0)
+		return;
+	std::memcpy(_reserve(length), s, length);
+	m_size += length;
+}
@@ -0,0 +1,94 @@
+/*
+ * Writer.hpp
+ * Serialises Variant trees, or values written one at a time, to JSON in a reusable buffer.  Output is
+ * compact by default, set_pretty adds newlines and indentation.
+ *
+ *  Created on: 18 Oct 2026
+ ****************************************************************************************************
+ *LICENSE: zlib/libpng
+ *
+ *Copyright (c) 2022 Liam Charalambous (@magellanicgames)
+ *
+ *This software is provided "as-is", without any express or implied warranty. In no event
+ *will the authors be held liable for any damages arising from the use of this software.
+ *
+ *Permission is granted to anyone to use this software for any purpose, including commercial
+ *applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *	1. The origin of this software must not be misrepresented; you must not claim that you
+ *	wrote the original software. If you use this software in a product, an acknowledgment
+ *	in the product documentation would be appreciated but is not required.
+ *
+ *	2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *  as being the original software.
+ *
+ *  3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************************************
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "StringRef.hpp"
+#include "Variant.hpp"
+
+namespace MJSON
+{
+	//Values can be streamed with the start_/end_/write_ functions, separators and indentation are added
+	//automatically.  The buffer keeps its capacity after clear(), so a Writer can be reused for every save.
+	class Writer
+	{
+	public:
+		Writer() = default;
+
+		void set_pretty(bool pretty, int indent_width = 4);
+		void clear(); //empties the output, keeping the buffer's capacity
+
+		StringRef get_output() const {return StringRef(m_buffer.data(), m_size);}
+		std::string to_string() const {return std::string(m_buffer.data(), m_size);}
+
+		void start_object();
+		void end_object();
+		void start_array();
+		void end_array();
+
+		void write_key(StringRef key);
+		void write_string(StringRef s); //escapes quotes, backslashes and control characters
+		void write_int(int64_t i);
+		void write_uint(uint64_t ui);
+		void write_float(float f);
+		void write_double(double d);
+		void write_bool(bool b);
+		void write_null();
+
+		//Strings in a parsed tree hold their text as it was in the source, escape sequences included, so
+		//parsed keys and strings are written unchanged rather than escaped again.  Those added in code are
+		//escaped.  Floats are
+		//written at double precision, only write_float rounds to float precision.
+		void write(const Variant& variant);
+
+	private:
+		void _before_value();
+		void _end_container(char c);
+		void _new_line();
+
+		void _write_escaped(StringRef s);
+		void _write_quoted_raw(StringRef s);
+		void _write_key_raw(StringRef key);
+
+		char* _reserve(std::size_t length); //returns where the next length characters are written
+		void _put(char c) {*_reserve(1) = c; m_size++;}
+		void _append(const char* s, std::size_t length);
+
+		std::string m_buffer;
+		std::size_t m_size = 0;
+
+		std::vector<char> m_has_values; //one entry per open container
+		bool m_after_key = false;
+		bool m_pretty = false;
+		int m_indent_width = 4;
+	};
+}
@@ -27,11 +27,19 @@
  */
 
 #include "JSONTestParser.hpp"
+#include "JSONBenchmark.hpp"
+#include <string>
 
 int main(int argc, char *argv[])
 {
 	MJSON::JSONTestParser test;
 	test.test_parser();
+
+	if(argc > 1 && std::string(argv[1]) == "bench")
+	{
+		MJSON::JSONBenchmark benchmark;
+		benchmark.run_benchmarks();
+	}
 	return 0;
 }
 